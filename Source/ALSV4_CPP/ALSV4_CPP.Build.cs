@@ -26,5 +26,11 @@ public class ALSV4_CPP : ModuleRules
 		});
 
 		PrivateDependencyModuleNames.AddRange(new[] {"Slate", "SlateCore"});
+
+		// Automation tests that run play in editor sessions.
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 	}
 }
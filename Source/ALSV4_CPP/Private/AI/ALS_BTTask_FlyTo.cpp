@@ -0,0 +1,147 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "AI/ALS_BTTask_FlyTo.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Character/ALSBaseCharacter.h"
+
+UALS_BTTask_FlyTo::UALS_BTTask_FlyTo()
+{
+	NodeName = "Fly To";
+	bNotifyTick = true;
+	bNotifyTaskFinished = true;
+
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UALS_BTTask_FlyTo, BlackboardKey));
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UALS_BTTask_FlyTo, BlackboardKey), AActor::StaticClass());
+}
+
+EBTNodeResult::Type UALS_BTTask_FlyTo::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	const UALSFlightNavSubsystem* FlightNav = GetWorld()->GetSubsystem<UALSFlightNavSubsystem>();
+	APawn* Pawn = OwnerComp.GetAIOwner()->GetPawn();
+	const UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+
+	if (!FlightNav || !Pawn || !Blackboard)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FVector Goal;
+	if (BlackboardKey.SelectedKeyType == UBlackboardKeyType_Object::StaticClass())
+	{
+		const AActor* GoalActor = Cast<AActor>(Blackboard->GetValueAsObject(BlackboardKey.SelectedKeyName));
+		if (!GoalActor)
+		{
+			return EBTNodeResult::Failed;
+		}
+		Goal = GoalActor->GetActorLocation();
+	}
+	else
+	{
+		Goal = Blackboard->GetValueAsVector(BlackboardKey.SelectedKeyName);
+	}
+
+	FALSFlyToMemory* Memory = CastInstanceNodeMemory<FALSFlyToMemory>(NodeMemory);
+	Memory->Query = FlightNav->FindPathAsync(Pawn->GetActorLocation(), Goal, MaxIterations);
+	Memory->Path.Reset();
+	Memory->PathIndex = 0;
+
+	if (!Memory->Query)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	AALSBaseCharacter* Character = Cast<AALSBaseCharacter>(Pawn);
+	if (bStartFlying && Character && Character->GetFlightState() == EALSFlightState::None)
+	{
+		Character->SetFlightState(EALSFlightState::Hovering);
+	}
+
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type UALS_BTTask_FlyTo::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	return EBTNodeResult::Aborted;
+}
+
+void UALS_BTTask_FlyTo::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	FALSFlyToMemory* Memory = CastInstanceNodeMemory<FALSFlyToMemory>(NodeMemory);
+	APawn* Pawn = OwnerComp.GetAIOwner()->GetPawn();
+
+	if (!Pawn)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	if (Memory->Query)
+	{
+		if (!Memory->Query->bComplete)
+		{
+			return;
+		}
+
+		if (!Memory->Query->bSuccess)
+		{
+			FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+			return;
+		}
+
+		// The first point is where the pawn started.
+		Memory->Path = MoveTemp(Memory->Query->Path);
+		Memory->PathIndex = 1;
+		Memory->Query.Reset();
+	}
+
+	const FVector Location = Pawn->GetActorLocation();
+	while (Memory->Path.IsValidIndex(Memory->PathIndex) &&
+		FVector::DistSquared(Location, Memory->Path[Memory->PathIndex]) <= FMath::Square(AcceptableRadius))
+	{
+		Memory->PathIndex++;
+	}
+
+	if (!Memory->Path.IsValidIndex(Memory->PathIndex))
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	Pawn->AddMovementInput((Memory->Path[Memory->PathIndex] - Location).GetSafeNormal());
+}
+
+void UALS_BTTask_FlyTo::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+                                       const EBTNodeResult::Type TaskResult)
+{
+	FALSFlyToMemory* Memory = CastInstanceNodeMemory<FALSFlyToMemory>(NodeMemory);
+	Memory->Query.Reset();
+	Memory->Path.Empty();
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+uint16 UALS_BTTask_FlyTo::GetInstanceMemorySize() const
+{
+	return sizeof(FALSFlyToMemory);
+}
+
+void UALS_BTTask_FlyTo::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+                                         EBTMemoryInit::Type InitType) const
+{
+	new(NodeMemory) FALSFlyToMemory();
+}
+
+void UALS_BTTask_FlyTo::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+                                      EBTMemoryClear::Type CleanupType) const
+{
+	CastInstanceNodeMemory<FALSFlyToMemory>(NodeMemory)->~FALSFlyToMemory();
+}
+
+FString UALS_BTTask_FlyTo::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Fly To: %s\nAcceptable Radius: %d"), *BlackboardKey.SelectedKeyName.ToString(),
+	                       FMath::RoundToInt(AcceptableRadius));
+}
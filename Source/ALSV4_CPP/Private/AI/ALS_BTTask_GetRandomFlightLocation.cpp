@@ -0,0 +1,38 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "AI/ALS_BTTask_GetRandomFlightLocation.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Subsystems/ALSFlightNavSubsystem.h"
+
+UALS_BTTask_GetRandomFlightLocation::UALS_BTTask_GetRandomFlightLocation()
+{
+	NodeName = "Get Random Flight Location";
+
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UALS_BTTask_GetRandomFlightLocation, BlackboardKey));
+}
+
+EBTNodeResult::Type UALS_BTTask_GetRandomFlightLocation::ExecuteTask(UBehaviorTreeComponent& OwnerComp,
+                                                                     uint8* NodeMemory)
+{
+	const UALSFlightNavSubsystem* FlightNav = GetWorld()->GetSubsystem<UALSFlightNavSubsystem>();
+	APawn* Pawn = OwnerComp.GetAIOwner()->GetPawn();
+
+	if (FlightNav && Pawn)
+	{
+		FVector Destination;
+		if (FlightNav->GetRandomReachablePoint(Pawn->GetActorLocation(), MaxDistance, Destination))
+		{
+			OwnerComp.GetBlackboardComponent()->SetValueAsVector(BlackboardKey.SelectedKeyName, Destination);
+			return EBTNodeResult::Succeeded;
+		}
+	}
+
+	return EBTNodeResult::Failed;
+}
+
+FString UALS_BTTask_GetRandomFlightLocation::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Get Random Flight Location\nMax Distance: %d"), FMath::RoundToInt(MaxDistance));
+}
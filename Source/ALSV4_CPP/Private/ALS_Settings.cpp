@@ -0,0 +1,10 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "ALS_Settings.h"
+
+#include "Engine/World.h"
+
+bool UALS_Settings::IsCosmeticFreeServer(const UWorld* World)
+{
+	return IsValid(World) && World->GetNetMode() == NM_DedicatedServer && Get()->bCosmeticFreeDedicatedServer;
+}
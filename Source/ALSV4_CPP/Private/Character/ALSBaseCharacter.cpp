@@ -6,21 +6,28 @@
 
 #include "ALSStaticNames.h"
 #include "ALS_Settings.h"
+#include "Animation/AnimMontage.h"
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
 #include "Components/ALSDebugComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Curves/CurveFloat.h"
+#include "Engine/SkeletalMesh.h"
 #include "Character/ALSCharacterMovementComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "Components/ALSFlightComponent.h"
+#include "Subsystems/ALSHitFXPreloadSubsystem.h"
 #include "Net/UnrealNetwork.h"
 
 using namespace ALS::BaseCharacter;
 
+DEFINE_LOG_CATEGORY(LogAlsBaseCharacter)
+
 AALSBaseCharacter::AALSBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UALSCharacterMovementComponent>(CharacterMovementComponentName))
 {
@@ -40,19 +47,28 @@ void AALSBaseCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AALSBaseCharacter, TargetRagdollLocation);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedRagdollLocation, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedCurrentAcceleration, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedControlRotation, COND_SkipOwner);
 
-	DOREPLIFETIME(AALSBaseCharacter, DesiredGait);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, DesiredStance, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, DesiredRotationMode, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedState, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedMontage, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, VisibleMeshID, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, UnregisteredVisibleMesh, COND_SkipOwner);
+}
+
+float AALSBaseCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer,
+                                        AActor* ViewTarget, UActorChannel* InChannel, const float Time,
+                                        const bool bLowBandwidth)
+{
+	float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+
+	if (NetUpdatePolicy.bEnabled && !NetUpdatePolicy.DistanceBands.IsEmpty())
+	{
+		Priority *= NetUpdatePolicy.GetBand(FVector::DistSquared(ViewPos, GetActorLocation())).NetPriorityScale;
+	}
 
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, RotationMode, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, OverlayState, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, FlightState, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ViewMode, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, VisibleMesh, COND_SkipOwner);
+	return Priority;
 }
 
 void AALSBaseCharacter::AddMovementInput(FVector WorldDirection, float ScaleValue, const bool bForce)
@@ -65,6 +81,16 @@ void AALSBaseCharacter::AddMovementInput(FVector WorldDirection, float ScaleValu
 	Super::AddMovementInput(WorldDirection, ScaleValue, bForce);
 }
 
+void AALSBaseCharacter::SetCosmeticFreeServer(const bool bCosmeticFree)
+{
+	bCosmeticFreeServer = bCosmeticFree;
+
+	if (UALSCharacterAnimInstance* AnimInstance = Cast<UALSCharacterAnimInstance>(GetMesh()->GetAnimInstance()))
+	{
+		AnimInstance->SetCosmeticFree(bCosmeticFree);
+	}
+}
+
 void AALSBaseCharacter::OnBreakfall_Implementation()
 {
 	Replicated_PlayMontage(GetRollAnimation(), 1.35);
@@ -72,13 +98,36 @@ void AALSBaseCharacter::OnBreakfall_Implementation()
 
 void AALSBaseCharacter::Replicated_PlayMontage_Implementation(UAnimMontage* Montage, const float PlayRate)
 {
+	// Simulated proxies get the montage from ReplicatedMontage instead.
+	if (GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		return;
+	}
+
 	// Roll: Simply play a Root Motion Montage.
 	if (GetMesh()->GetAnimInstance())
 	{
 		GetMesh()->GetAnimInstance()->Montage_Play(Montage, PlayRate);
 	}
 
-	Server_PlayMontage(Montage, PlayRate);
+	if (!IsValid(Montage))
+	{
+		return;
+	}
+
+	const uint8 MontageID = GetMontageNetID(Montage);
+	if (HasAuthority())
+	{
+		SetReplicatedMontage(MontageID, Montage, PlayRate);
+	}
+	else if (MontageID != UALSNetAssetRegistry::InvalidID)
+	{
+		Server_PlayMontage(MontageID, PlayRate);
+	}
+	else
+	{
+		Server_PlayMontageObject(Montage, PlayRate);
+	}
 }
 
 void AALSBaseCharacter::BeginPlay()
@@ -87,6 +136,7 @@ void AALSBaseCharacter::BeginPlay()
 
 	// If we're in networked game, disable curved movement
 	bEnableNetworkOptimizations = !IsNetMode(NM_Standalone);
+	bCosmeticFreeServer = UALS_Settings::IsCosmeticFreeServer(GetWorld());
 
 	// Make sure the mesh and AnimBP update after the CharacterBP to ensure it gets the most recent values.
 	GetMesh()->AddTickPrerequisiteActor(this);
@@ -118,6 +168,27 @@ void AALSBaseCharacter::BeginPlay()
 	// Find optional components
 	ALSDebugComponent = FindComponentByClass<UALSDebugComponent>();
 	ALSFlightComponent = FindComponentByClass<UALSFlightComponent>();
+
+	// Stream in the footstep effects of animations this character brought into memory.
+	if (!bCosmeticFreeServer)
+	{
+		if (UALSHitFXPreloadSubsystem* HitFXPreloader = GetWorld()->GetSubsystem<UALSHitFXPreloadSubsystem>())
+		{
+			HitFXPreloader->RequestScan();
+		}
+	}
+
+	if (HasAuthority() && !IsNetMode(NM_Standalone) &&
+		NetUpdatePolicy.bEnabled && !NetUpdatePolicy.DistanceBands.IsEmpty())
+	{
+		DefaultMinNetUpdateFrequency = MinNetUpdateFrequency;
+		LastNetActiveTime = GetWorld()->GetTimeSeconds();
+
+		// Random first delay, so characters spawned together don't all evaluate on the same frame.
+		const float Interval = NetUpdatePolicy.EvaluationInterval;
+		GetWorldTimerManager().SetTimer(NetUpdatePolicyTimer, this, &AALSBaseCharacter::UpdateNetUpdateFrequency,
+		                                Interval, true, FMath::FRandRange(0.0f, Interval));
+	}
 }
 
 void AALSBaseCharacter::Tick(const float DeltaTime)
@@ -141,13 +212,6 @@ void AALSBaseCharacter::Tick(const float DeltaTime)
 			}
 		case EALSMovementState::Freefall:
 			{
-				// @TODO flight catching should really be in the movement state machine not in the flight component.
-				if (ALSFlightComponent && ALSFlightComponent->WantsToCatchFalling())
-				{
-					SetFlightState(EALSFlightState::Hovering);
-					break;
-				}
-
 				UpdateFallingRotation(DeltaTime);
 				break;
 			}
@@ -188,13 +252,20 @@ void AALSBaseCharacter::RagdollStart()
 	and if the host is a dedicated server, change character mesh optimisation option to avoid z-location bug*/
 	MyCharacterMovementComponent->bIgnoreClientMovementErrorChecksAndCorrection = 1;
 
-	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	// A cosmetic free server reads the ragdoll bodies directly instead, see GetRagdollBoneTransform.
+	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()) && !bCosmeticFreeServer)
 	{
 		DefVisBasedTickOp = GetMesh()->VisibilityBasedAnimTickOption;
 		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
 	}
-	TargetRagdollLocation = GetMesh()->GetSocketLocation(NAME_Pelvis);
+	TargetRagdollLocation = GetRagdollBoneTransform(NAME_Pelvis).GetLocation();
 	ServerRagdollPull = 0;
+	BumpNetUpdateFrequency();
+
+	// Start remote interpolation from where the ragdoll is locally, until the owner's locations arrive.
+	RagdollSnapshots.Reset();
+	RagdollSnapshots.Add(GetWorld()->GetTimeSeconds(), TargetRagdollLocation);
+	RagdollSyncTimeAccumulator = 0.0f;
 
 	// Disable URO
 	bPreRagdollURO = GetMesh()->bEnableUpdateRateOptimizations;
@@ -227,7 +298,7 @@ void AALSBaseCharacter::RagdollEnd()
 	/** Re-enable Replicate Movement and if the host is a dedicated server set mesh visibility based anim
 	tick option back to default*/
 
-	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()) && !bCosmeticFreeServer)
 	{
 		GetMesh()->VisibilityBasedAnimTickOption = DefVisBasedTickOp;
 	}
@@ -273,9 +344,10 @@ void AALSBaseCharacter::RagdollEnd()
 	}
 }
 
-void AALSBaseCharacter::Server_SetMeshLocationDuringRagdoll_Implementation(const FVector MeshLocation)
+void AALSBaseCharacter::Server_SetMeshLocationDuringRagdoll_Implementation(const FVector_NetQuantize MeshLocation)
 {
-	TargetRagdollLocation = MeshLocation;
+	ReplicatedRagdollLocation = MeshLocation;
+	ReceiveRagdollLocation(MeshLocation);
 }
 
 void AALSBaseCharacter::SetMovementState(const EALSMovementState NewState, const bool bForce)
@@ -326,6 +398,8 @@ void AALSBaseCharacter::SetGait(const EALSGait NewGait, const bool bForce)
 void AALSBaseCharacter::SetDesiredStance(const EALSStance NewStance)
 {
 	DesiredStance = NewStance;
+	UpdateReplicatedState();
+
 	if (GetLocalRole() == ROLE_AutonomousProxy)
 	{
 		Server_SetDesiredStance(NewStance);
@@ -340,6 +414,8 @@ void AALSBaseCharacter::Server_SetDesiredStance_Implementation(const EALSStance
 void AALSBaseCharacter::SetDesiredGait(const EALSGait NewGait)
 {
 	DesiredGait = NewGait;
+	UpdateReplicatedState();
+
 	if (GetLocalRole() == ROLE_AutonomousProxy)
 	{
 		Server_SetDesiredGait(NewGait);
@@ -354,6 +430,8 @@ void AALSBaseCharacter::Server_SetDesiredGait_Implementation(const EALSGait NewG
 void AALSBaseCharacter::SetDesiredRotationMode(const EALSRotationMode NewRotMode)
 {
 	DesiredRotationMode = NewRotMode;
+	UpdateReplicatedState();
+
 	if (GetLocalRole() == ROLE_AutonomousProxy)
 	{
 		Server_SetDesiredRotationMode(NewRotMode);
@@ -372,6 +450,7 @@ void AALSBaseCharacter::SetRotationMode(const EALSRotationMode NewRotationMode,
 		const EALSRotationMode Prev = RotationMode;
 		RotationMode = NewRotationMode;
 		OnRotationModeChanged(Prev);
+		UpdateReplicatedState();
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
@@ -392,6 +471,7 @@ void AALSBaseCharacter::SetViewMode(const EALSViewMode NewViewMode, const bool b
 		const EALSViewMode Prev = ViewMode;
 		ViewMode = NewViewMode;
 		OnViewModeChanged(Prev);
+		UpdateReplicatedState();
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
@@ -412,12 +492,16 @@ void AALSBaseCharacter::SetFlightState(const EALSFlightState NewFlightState, con
 		// If we are trying for a mode other than turning flight off, verify the character is able to fly.
 		if (NewFlightState != EALSFlightState::None)
 		{
-			if (!IsValid(ALSFlightComponent) && !ALSFlightComponent->CanFly()) return;
+			if (!IsValid(ALSFlightComponent) || !ALSFlightComponent->CanFly()) return;
 		}
 
 		const EALSFlightState Prev = FlightState;
 		FlightState = NewFlightState;
 		OnFlightStateChanged(Prev);
+		UpdateReplicatedState();
+
+		// Sent to the server with the next move, see UALSCharacterMovementComponent::RequestedFlightState.
+		MyCharacterMovementComponent->RequestedFlightState = NewFlightState;
 
 		if (FlightState == EALSFlightState::None) // We want to stop flight.
 		{
@@ -433,19 +517,9 @@ void AALSBaseCharacter::SetFlightState(const EALSFlightState NewFlightState, con
 		{
 			// Currently blank
 		}
-
-		if (GetLocalRole() == ROLE_AutonomousProxy)
-		{
-			Server_SetFlightState(NewFlightState, bForce);
-		}
 	}
 }
 
-void AALSBaseCharacter::Server_SetFlightState_Implementation(const EALSFlightState NewFlightState, const bool bForce)
-{
-	SetFlightState(NewFlightState);
-}
-
 void AALSBaseCharacter::SetOverlayState(const EALSOverlayState NewState, const bool bForce)
 {
 	if (bForce || OverlayState != NewState)
@@ -453,6 +527,8 @@ void AALSBaseCharacter::SetOverlayState(const EALSOverlayState NewState, const b
 		const EALSOverlayState Prev = OverlayState;
 		OverlayState = NewState;
 		OnOverlayStateChanged(Prev);
+		UpdateReplicatedState();
+		BumpNetUpdateFrequency();
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
 		{
@@ -495,14 +571,6 @@ void AALSBaseCharacter::EventOnLanded()
 	}
 }
 
-void AALSBaseCharacter::Multicast_OnLanded_Implementation()
-{
-	if (!IsLocallyControlled())
-	{
-		EventOnLanded();
-	}
-}
-
 void AALSBaseCharacter::EventOnJumped()
 {
 	// Set the new In Air Rotation to the velocity rotation if speed is greater than 100.
@@ -511,31 +579,41 @@ void AALSBaseCharacter::EventOnJumped()
 	OnJumpedDelegate.Broadcast();
 }
 
-void AALSBaseCharacter::Server_PlayMontage_Implementation(UAnimMontage* Montage, const float PlayRate)
+void AALSBaseCharacter::Server_PlayMontage_Implementation(const uint8 MontageID, const float PlayRate)
 {
+	if (!NetAssetRegistry)
+	{
+		return;
+	}
+
+	// Reject IDs that are not in the registry, instead of replicating a montage no one can play.
+	UAnimMontage* Montage = NetAssetRegistry->GetMontage(MontageID);
+	if (!Montage)
+	{
+		return;
+	}
+
 	if (GetMesh()->GetAnimInstance())
 	{
 		GetMesh()->GetAnimInstance()->Montage_Play(Montage, PlayRate);
 	}
 
-	ForceNetUpdate();
-	Multicast_PlayMontage(Montage, PlayRate);
+	SetReplicatedMontage(MontageID, nullptr, PlayRate);
 }
 
-void AALSBaseCharacter::Multicast_PlayMontage_Implementation(UAnimMontage* Montage, const float PlayRate)
+void AALSBaseCharacter::Server_PlayMontageObject_Implementation(UAnimMontage* Montage, const float PlayRate)
 {
-	if (GetMesh()->GetAnimInstance() && !IsLocallyControlled())
+	if (!IsValid(Montage))
 	{
-		GetMesh()->GetAnimInstance()->Montage_Play(Montage, PlayRate);
+		return;
 	}
-}
 
-void AALSBaseCharacter::Multicast_OnJumped_Implementation()
-{
-	if (!IsLocallyControlled())
+	if (GetMesh()->GetAnimInstance())
 	{
-		EventOnJumped();
+		GetMesh()->GetAnimInstance()->Montage_Play(Montage, PlayRate);
 	}
+
+	SetReplicatedMontage(GetMontageNetID(Montage), Montage, PlayRate);
 }
 
 void AALSBaseCharacter::Server_RagdollStart_Implementation()
@@ -681,16 +759,43 @@ void AALSBaseCharacter::SetVisibleMesh(USkeletalMesh* NewVisibleMesh)
 		VisibleMesh = NewVisibleMesh;
 		OnVisibleMeshChanged(Prev);
 
-		if (GetLocalRole() != ROLE_Authority)
+		const uint8 MeshID = GetMeshNetID(NewVisibleMesh);
+		if (GetLocalRole() == ROLE_Authority)
 		{
-			Server_SetVisibleMesh(NewVisibleMesh);
+			SetReplicatedVisibleMesh(MeshID, NewVisibleMesh);
+		}
+		else if (MeshID != UALSNetAssetRegistry::InvalidID || !NewVisibleMesh)
+		{
+			Server_SetVisibleMesh(MeshID);
+		}
+		else
+		{
+			Server_SetVisibleMeshObject(NewVisibleMesh);
 		}
 	}
 }
 
-void AALSBaseCharacter::Server_SetVisibleMesh_Implementation(USkeletalMesh* NewVisibleMesh)
+void AALSBaseCharacter::Server_SetVisibleMesh_Implementation(const uint8 MeshID)
 {
+	USkeletalMesh* NewVisibleMesh = NetAssetRegistry ? NetAssetRegistry->GetMesh(MeshID) : nullptr;
+	if (NewVisibleMesh)
+	{
+		SetVisibleMesh(NewVisibleMesh);
+	}
+
+	// Also set when the server's mesh did not change, e.g. after the owner used an unregistered mesh in between.
+	SetReplicatedVisibleMesh(NewVisibleMesh ? MeshID : UALSNetAssetRegistry::InvalidID, nullptr);
+}
+
+void AALSBaseCharacter::Server_SetVisibleMeshObject_Implementation(USkeletalMesh* NewVisibleMesh)
+{
+	if (!IsValid(NewVisibleMesh))
+	{
+		return;
+	}
+
 	SetVisibleMesh(NewVisibleMesh);
+	SetReplicatedVisibleMesh(GetMeshNetID(NewVisibleMesh), NewVisibleMesh);
 }
 
 void AALSBaseCharacter::SetRightShoulder(const bool bNewRightShoulder)
@@ -755,15 +860,17 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	if (IsLocallyControlled())
 	{
 		// Set the pelvis as the target location.
-		TargetRagdollLocation = GetMesh()->GetSocketLocation(NAME_Pelvis);
-		if (!HasAuthority())
-		{
-			Server_SetMeshLocationDuringRagdoll(TargetRagdollLocation);
-		}
+		TargetRagdollLocation = GetRagdollBoneTransform(NAME_Pelvis).GetLocation();
+		SendRagdollLocation(DeltaTime);
+	}
+	else if (RagdollSyncMode == EALSRagdollSyncMode::Interpolated && !RagdollSnapshots.IsEmpty())
+	{
+		const float Delay = RagdollInterpolationDelay / RagdollSyncRate;
+		TargetRagdollLocation = RagdollSnapshots.Sample(GetWorld()->GetTimeSeconds() - Delay);
 	}
 
 	// Determine whether the ragdoll is facing up or down and set the target rotation accordingly.
-	const FRotator PelvisRot = GetMesh()->GetSocketRotation(NAME_Pelvis);
+	const FRotator PelvisRot = GetRagdollBoneTransform(NAME_Pelvis).Rotator();
 
 	if (bReversedPelvis)
 	{
@@ -819,12 +926,61 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 		float RagdollSpeed = FVector(LastRagdollVelocity.X, LastRagdollVelocity.Y, 0).Size();
 		FName RagdollSocketPullName = RagdollSpeed > 300 ? NAME_spine_03 : NAME_pelvis;
 		GetMesh()->AddForce(
-			(TargetRagdollLocation - GetMesh()->GetSocketLocation(RagdollSocketPullName)) * ServerRagdollPull,
+			(TargetRagdollLocation - GetRagdollBoneTransform(RagdollSocketPullName).GetLocation()) * ServerRagdollPull,
 			RagdollSocketPullName, true);
 	}
 	SetActorLocationAndTargetRotation(bRagdollOnGround ? NewRagdollLoc : TargetRagdollLocation, TargetRagdollRotation);
 }
 
+FTransform AALSBaseCharacter::GetRagdollBoneTransform(const FName BoneName) const
+{
+	// Bones are not refreshed on a cosmetic free server, but the simulated bodies are always up to date.
+	if (bCosmeticFreeServer)
+	{
+		if (const FBodyInstance* BodyInstance = GetMesh()->GetBodyInstance(BoneName))
+		{
+			return BodyInstance->GetUnrealWorldTransform();
+		}
+	}
+
+	return GetMesh()->GetSocketTransform(BoneName);
+}
+
+void AALSBaseCharacter::SendRagdollLocation(const float DeltaTime)
+{
+	if (RagdollSyncMode == EALSRagdollSyncMode::Interpolated)
+	{
+		const float SendInterval = 1.0f / RagdollSyncRate;
+		RagdollSyncTimeAccumulator += DeltaTime;
+		if (RagdollSyncTimeAccumulator < SendInterval)
+		{
+			return;
+		}
+		RagdollSyncTimeAccumulator = FMath::Fmod(RagdollSyncTimeAccumulator, SendInterval);
+	}
+
+	if (HasAuthority())
+	{
+		ReplicatedRagdollLocation = TargetRagdollLocation;
+	}
+	else
+	{
+		Server_SetMeshLocationDuringRagdoll(TargetRagdollLocation);
+	}
+}
+
+void AALSBaseCharacter::ReceiveRagdollLocation(const FVector& Location)
+{
+	if (RagdollSyncMode == EALSRagdollSyncMode::Interpolated)
+	{
+		RagdollSnapshots.Add(GetWorld()->GetTimeSeconds(), Location);
+	}
+	else
+	{
+		TargetRagdollLocation = Location;
+	}
+}
+
 void AALSBaseCharacter::OnMovementModeChanged(const EMovementMode PrevMovementMode, const uint8 PreviousCustomMode)
 {
 	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
@@ -843,6 +999,21 @@ void AALSBaseCharacter::OnMovementModeChanged(const EMovementMode PrevMovementMo
 	case MOVE_MAX: SetMovementState(EALSMovementState::None); break;
 	default: SetMovementState(EALSMovementState::None); break;
 	}
+
+	// Simulated proxies never get Landed or OnJumped called, so derive both events from the replicated movement mode.
+	if (GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		const bool bWasGrounded = PrevMovementMode == MOVE_Walking || PrevMovementMode == MOVE_NavWalking;
+
+		if (PrevMovementMode == MOVE_Falling && GetCharacterMovement()->IsMovingOnGround())
+		{
+			EventOnLanded();
+		}
+		else if (bWasGrounded && GetCharacterMovement()->IsFalling() && GetVelocity().Z > 0.0f)
+		{
+			EventOnJumped();
+		}
+	}
 }
 
 void AALSBaseCharacter::OnMovementStateChanged(const EALSMovementState PreviousState)
@@ -1010,28 +1181,23 @@ void AALSBaseCharacter::OnEndCrouch(const float HalfHeightAdjust, const float Sc
 void AALSBaseCharacter::OnJumped_Implementation()
 {
 	Super::OnJumped_Implementation();
-	if (IsLocallyControlled())
+
+	// Simulated proxies handle this in OnMovementModeChanged.
+	if (IsLocallyControlled() || HasAuthority())
 	{
 		EventOnJumped();
 	}
-	if (HasAuthority())
-	{
-		Multicast_OnJumped();
-	}
 }
 
 void AALSBaseCharacter::Landed(const FHitResult& Hit)
 {
 	Super::Landed(Hit);
 
-	if (IsLocallyControlled())
+	// Simulated proxies handle this in OnMovementModeChanged.
+	if (IsLocallyControlled() || HasAuthority())
 	{
 		EventOnLanded();
 	}
-	if (HasAuthority())
-	{
-		Multicast_OnLanded();
-	}
 }
 
 void AALSBaseCharacter::OnLandFrictionReset()
@@ -1559,27 +1725,232 @@ void AALSBaseCharacter::ReplicatedRagdollEnd()
 	}
 }
 
-void AALSBaseCharacter::OnRep_RotationMode(const EALSRotationMode PrevRotMode)
+void AALSBaseCharacter::UpdateReplicatedState()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	ReplicatedState.DesiredGait = DesiredGait;
+	ReplicatedState.DesiredStance = DesiredStance;
+	ReplicatedState.DesiredRotationMode = DesiredRotationMode;
+	ReplicatedState.RotationMode = RotationMode;
+	ReplicatedState.OverlayState = OverlayState;
+	ReplicatedState.FlightState = FlightState;
+	ReplicatedState.ViewMode = ViewMode;
+}
+
+void AALSBaseCharacter::OnRep_ReplicatedState()
+{
+	const EALSOverlayState PrevOverlayState = OverlayState;
+	const EALSRotationMode PrevRotationMode = RotationMode;
+	const EALSViewMode PrevViewMode = ViewMode;
+	const EALSFlightState PrevFlightState = FlightState;
+
+	// Apply every value before calling any handler, so that handlers never observe a half updated state.
+	DesiredGait = ReplicatedState.DesiredGait;
+	DesiredStance = ReplicatedState.DesiredStance;
+	DesiredRotationMode = ReplicatedState.DesiredRotationMode;
+	OverlayState = ReplicatedState.OverlayState;
+	RotationMode = ReplicatedState.RotationMode;
+	ViewMode = ReplicatedState.ViewMode;
+	FlightState = ReplicatedState.FlightState;
+
+	if (OverlayState != PrevOverlayState)
+	{
+		OnOverlayStateChanged(PrevOverlayState);
+	}
+
+	if (RotationMode != PrevRotationMode)
+	{
+		OnRotationModeChanged(PrevRotationMode);
+	}
+
+	if (ViewMode != PrevViewMode)
+	{
+		OnViewModeChanged(PrevViewMode);
+	}
+
+	if (FlightState != PrevFlightState)
+	{
+		OnFlightStateChanged(PrevFlightState);
+	}
+}
+
+void AALSBaseCharacter::SetReplicatedMontage(const uint8 MontageID, UAnimMontage* Montage, const float PlayRate)
+{
+	ReplicatedMontage.MontageID = MontageID;
+	ReplicatedMontage.Montage = MontageID == UALSNetAssetRegistry::InvalidID ? Montage : nullptr;
+	ReplicatedMontage.StartServerTime = GetServerWorldTimeSeconds();
+	ReplicatedMontage.PlayRate = PlayRate;
+	ForceNetUpdate();
+}
+
+void AALSBaseCharacter::SetReplicatedVisibleMesh(const uint8 MeshID, USkeletalMesh* Mesh)
+{
+	VisibleMeshID = MeshID;
+	UnregisteredVisibleMesh = MeshID == UALSNetAssetRegistry::InvalidID ? Mesh : nullptr;
+}
+
+void AALSBaseCharacter::BumpNetUpdateFrequency()
+{
+	if (!HasAuthority() || !NetUpdatePolicyTimer.IsValid())
+	{
+		return;
+	}
+
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+	NetUpdateBumpEndTime = WorldTime + NetUpdatePolicy.BumpDuration;
+	LastNetActiveTime = WorldTime;
+
+	NetUpdateFrequency = NetUpdatePolicy.DistanceBands[0].NetUpdateFrequency;
+	MinNetUpdateFrequency = FMath::Min(DefaultMinNetUpdateFrequency, NetUpdateFrequency);
+	ForceNetUpdate();
+}
+
+void AALSBaseCharacter::UpdateNetUpdateFrequency()
+{
+	const UWorld* World = GetWorld();
+	const float WorldTime = World->GetTimeSeconds();
+
+	if (bHasMovementInput || bIsMoving || MovementState == EALSMovementState::Ragdoll ||
+		MovementAction != EALSMovementAction::None)
+	{
+		LastNetActiveTime = WorldTime;
+	}
+
+	// Remote players see the aim through ReplicatedControlRotation, so a character that only looks around isn't idle.
+	if (!ReplicatedControlRotation.Equals(LastNetControlRotation, NetUpdatePolicy.IdleControlRotationTolerance))
+	{
+		LastNetControlRotation = ReplicatedControlRotation;
+		LastNetActiveTime = WorldTime;
+	}
+
+	if (WorldTime < NetUpdateBumpEndTime)
+	{
+		return;
+	}
+
+	// The closest viewer decides, as NetUpdateFrequency is shared by all connections.
+	// Per connection scaling happens in GetNetPriority.
+	float ClosestDistanceSquared = MAX_flt;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr || PlayerController == GetController())
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared,
+		                                    FVector::DistSquared(ViewLocation, GetActorLocation()));
+	}
+
+	float NewFrequency = NetUpdatePolicy.GetBand(ClosestDistanceSquared).NetUpdateFrequency;
+	if (WorldTime - LastNetActiveTime >= NetUpdatePolicy.IdleDelay)
+	{
+		NewFrequency = FMath::Min(NewFrequency, NetUpdatePolicy.IdleNetUpdateFrequency);
+	}
+
+	NetUpdateFrequency = NewFrequency;
+	MinNetUpdateFrequency = FMath::Min(DefaultMinNetUpdateFrequency, NewFrequency);
+}
+
+void AALSBaseCharacter::OnRep_ReplicatedMontage()
 {
-	OnRotationModeChanged(PrevRotMode);
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	if (!AnimInstance)
+	{
+		return;
+	}
+
+	UAnimMontage* Montage = ReplicatedMontage.Montage;
+	if (!Montage && NetAssetRegistry)
+	{
+		Montage = NetAssetRegistry->GetMontage(ReplicatedMontage.MontageID);
+	}
+	if (!IsValid(Montage))
+	{
+		return;
+	}
+
+	// Start at the position the montage is at on the server, or skip it entirely if it has already finished.
+	const float ElapsedTime = FMath::Max(GetServerWorldTimeSeconds() - ReplicatedMontage.StartServerTime, 0.0f);
+	const float StartPosition = ElapsedTime * ReplicatedMontage.PlayRate;
+	if (StartPosition < Montage->GetPlayLength())
+	{
+		AnimInstance->Montage_Play(Montage, ReplicatedMontage.PlayRate, EMontagePlayReturnType::MontageLength, StartPosition);
+	}
 }
 
-void AALSBaseCharacter::OnRep_FlightState(const EALSFlightState PrevFlightState)
+uint8 AALSBaseCharacter::GetMontageNetID(const UAnimMontage* Montage) const
 {
-	OnFlightStateChanged(PrevFlightState);
+	if (!IsValid(Montage))
+	{
+		return UALSNetAssetRegistry::InvalidID;
+	}
+
+	const uint8 ID = NetAssetRegistry ? NetAssetRegistry->GetMontageID(Montage) : UALSNetAssetRegistry::InvalidID;
+	if (ID == UALSNetAssetRegistry::InvalidID)
+	{
+		UE_LOG(LogAlsBaseCharacter, Verbose, TEXT("Montage %s is missing from the NetAssetRegistry of %s, sending it by reference"),
+		       *Montage->GetName(), *GetName());
+	}
+	return ID;
+}
+
+uint8 AALSBaseCharacter::GetMeshNetID(const USkeletalMesh* Mesh) const
+{
+	if (!IsValid(Mesh))
+	{
+		return UALSNetAssetRegistry::InvalidID;
+	}
+
+	const uint8 ID = NetAssetRegistry ? NetAssetRegistry->GetMeshID(Mesh) : UALSNetAssetRegistry::InvalidID;
+	if (ID == UALSNetAssetRegistry::InvalidID)
+	{
+		UE_LOG(LogAlsBaseCharacter, Verbose, TEXT("Mesh %s is missing from the NetAssetRegistry of %s, sending it by reference"),
+		       *Mesh->GetName(), *GetName());
+	}
+	return ID;
 }
 
-void AALSBaseCharacter::OnRep_ViewMode(const EALSViewMode PrevViewMode)
+float AALSBaseCharacter::GetServerWorldTimeSeconds() const
 {
-	OnViewModeChanged(PrevViewMode);
+	const UWorld* World = GetWorld();
+	check(World);
+
+	if (const AGameStateBase* GameState = World->GetGameState())
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+
+	return World->GetTimeSeconds();
 }
 
-void AALSBaseCharacter::OnRep_OverlayState(const EALSOverlayState PrevOverlayState)
+void AALSBaseCharacter::OnRep_ReplicatedRagdollLocation()
 {
-	OnOverlayStateChanged(PrevOverlayState);
+	if (MovementState == EALSMovementState::Ragdoll)
+	{
+		ReceiveRagdollLocation(ReplicatedRagdollLocation);
+	}
 }
 
-void AALSBaseCharacter::OnRep_VisibleMesh(USkeletalMesh* NewVisibleMesh)
+void AALSBaseCharacter::OnRep_VisibleMesh()
 {
-	OnVisibleMeshChanged(NewVisibleMesh);
+	USkeletalMesh* NewVisibleMesh = UnregisteredVisibleMesh;
+	if (!NewVisibleMesh && NetAssetRegistry)
+	{
+		NewVisibleMesh = NetAssetRegistry->GetMesh(VisibleMeshID);
+	}
+	if (NewVisibleMesh && NewVisibleMesh != VisibleMesh)
+	{
+		const USkeletalMesh* Prev = VisibleMesh;
+		VisibleMesh = NewVisibleMesh;
+		OnVisibleMeshChanged(Prev);
+	}
 }
\ No newline at end of file
@@ -4,8 +4,20 @@
 
 #include "Character/ALSCharacterMovementComponent.h"
 #include "Character/ALSBaseCharacter.h"
+#include "Components/ALSFlightComponent.h"
 
 #include "Curves/CurveVector.h"
+#include "TimerManager.h"
+
+namespace ALS::CharacterMovement
+{
+	// The flight state is packed into FLAG_Custom_1 and FLAG_Custom_2 of the compressed move flags.
+	static constexpr uint8 FlightStateFlagShift = 5;
+	static constexpr uint8 FlightStateFlags = FSavedMove_Character::FLAG_Custom_1 | FSavedMove_Character::FLAG_Custom_2;
+	static_assert(FSavedMove_Character::FLAG_Custom_1 == 1 << FlightStateFlagShift, "Flight state flags moved");
+}
+
+using namespace ALS::CharacterMovement;
 
 UALSCharacterMovementComponent::UALSCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -49,6 +61,53 @@ void UALSCharacterMovementComponent::PhysWalking(const float DeltaTime, const in
 	Super::PhysWalking(DeltaTime, Iterations);
 }
 
+void UALSCharacterMovementComponent::PhysFlying(const float DeltaTime, int32 Iterations)
+{
+	const AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	const UALSFlightComponent* FlightComponent = ALSCharacter ? ALSCharacter->GetFlightComponent() : nullptr;
+	if (!IsValid(FlightComponent) || DeltaTime < MIN_TICK_TIME)
+	{
+		Super::PhysFlying(DeltaTime, Iterations);
+		return;
+	}
+
+	// Lift and drag are evaluated once per move, from the move's own location and velocity, and applied on every
+	// substep.
+	float LiftRatio, DragDeceleration, UpdraftAcceleration;
+	FlightComponent->CalculateMoveAero(RequestedFlightState, UpdatedComponent->GetComponentLocation(), Velocity,
+	                                   LiftRatio, DragDeceleration, UpdraftAcceleration);
+	const float NetGravityZ = GetGravityZ() * (1.0f - LiftRatio) + UpdraftAcceleration;
+	const float MaxAltitude = FlightComponent->GetMaxAltitude();
+
+	float RemainingTime = DeltaTime;
+	while (RemainingTime >= MIN_TICK_TIME && Iterations < MaxSimulationIterations &&
+		MovementMode == MOVE_Flying && HasValidData())
+	{
+		Iterations++;
+		const float TimeTick = GetSimulationTimeStep(RemainingTime, Iterations);
+		RemainingTime -= TimeTick;
+
+		if (!HasAnimRootMotion())
+		{
+			Velocity.Z += NetGravityZ * TimeTick;
+
+			const float CurrentSpeed = Velocity.Size();
+			if (CurrentSpeed > KINDA_SMALL_NUMBER)
+			{
+				Velocity *= FMath::Max(CurrentSpeed - DragDeceleration * TimeTick, 0.0f) / CurrentSpeed;
+			}
+		}
+
+		Super::PhysFlying(TimeTick, Iterations);
+
+		// Above the troposphere, flight can only descend.
+		if (Velocity.Z > 0.0f && UpdatedComponent->GetComponentLocation().Z >= MaxAltitude)
+		{
+			Velocity.Z = 0.0f;
+		}
+	}
+}
+
 float UALSCharacterMovementComponent::GetMaxAcceleration() const
 {
 	// Update the Acceleration using the Movement Curve.
@@ -76,6 +135,98 @@ void UALSCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags) // C
 	Super::UpdateFromCompressedFlags(Flags);
 
 	bRequestMovementSettingsChange = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+	RequestedFlightState = static_cast<EALSFlightState>((Flags & FlightStateFlags) >> FlightStateFlagShift);
+}
+
+void UALSCharacterMovementComponent::UpdateCharacterStateBeforeMovement(const float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	if (!ALSCharacter || ALSCharacter->GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		return;
+	}
+
+	if (!ALSCharacter->IsLocallyControlled())
+	{
+		// Server: Apply the flight state the client made this move with. Only takes effect on change.
+		if (ALSCharacter->GetFlightState() != RequestedFlightState)
+		{
+			ALSCharacter->SetFlightState(RequestedFlightState);
+		}
+		return;
+	}
+
+	// Owner: Replayed moves restore the movement mode they were originally made with.
+	const bool bWantsToFly = RequestedFlightState != EALSFlightState::None;
+	if (bWantsToFly && MovementMode != MOVE_Flying)
+	{
+		SetMovementMode(MOVE_Flying);
+	}
+	else if (!bWantsToFly && MovementMode == MOVE_Flying)
+	{
+		SetMovementMode(MOVE_Falling);
+	}
+}
+
+bool UALSCharacterMovementComponent::ClientUpdatePositionAfterServerUpdate()
+{
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+
+	// A correction can change the movement mode and with it the flight state. Continue with the state of the newest
+	// replayed move.
+	AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	if (ALSCharacter && ALSCharacter->GetFlightState() != RequestedFlightState)
+	{
+		ALSCharacter->SetFlightState(RequestedFlightState);
+	}
+
+	return bResult;
+}
+
+void UALSCharacterMovementComponent::OnMovementModeChanged(const EMovementMode PreviousMovementMode,
+                                                           const uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	// Replayed moves pass through old movement modes, which must not restart the countdown.
+	if (!CharacterOwner || !CharacterOwner->IsLocallyControlled() || CharacterOwner->bClientUpdating)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (!IsFalling())
+	{
+		TimerManager.ClearTimer(CatchFallingTimer);
+		return;
+	}
+
+	const AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	const UALSFlightComponent* FlightComponent = ALSCharacter ? ALSCharacter->GetFlightComponent() : nullptr;
+	if (FlightComponent && FlightComponent->GetTimeToWaitBeforeCatchFalling() >= 0.0f &&
+		!TimerManager.IsTimerActive(CatchFallingTimer))
+	{
+		TimerManager.SetTimer(CatchFallingTimer, this, &UALSCharacterMovementComponent::CatchFalling,
+		                      FMath::Max(FlightComponent->GetTimeToWaitBeforeCatchFalling(), KINDA_SMALL_NUMBER));
+	}
+}
+
+void UALSCharacterMovementComponent::CatchFalling()
+{
+	AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(CharacterOwner);
+	if (!ALSCharacter || !IsFalling())
+	{
+		return;
+	}
+
+	// Checked first, so that falling into a no-fly zone does not start flight just for SetFlightState to refuse it.
+	UALSFlightComponent* FlightComponent = ALSCharacter->GetFlightComponent();
+	if (FlightComponent && FlightComponent->CanFly() && FlightComponent->WantsToCatchFalling())
+	{
+		ALSCharacter->SetFlightState(EALSFlightState::Hovering);
+	}
 }
 
 class FNetworkPredictionData_Client* UALSCharacterMovementComponent::GetPredictionData_Client() const
@@ -100,6 +251,7 @@ void UALSCharacterMovementComponent::FSavedMove_My::Clear()
 
 	bSavedRequestMovementSettingsChange = false;
 	SavedAllowedGait = EALSGait::Walking;
+	SavedFlightState = EALSFlightState::None;
 }
 
 uint8 UALSCharacterMovementComponent::FSavedMove_My::GetCompressedFlags() const
@@ -111,6 +263,8 @@ uint8 UALSCharacterMovementComponent::FSavedMove_My::GetCompressedFlags() const
 		Result |= FLAG_Custom_0;
 	}
 
+	Result |= (static_cast<uint8>(SavedFlightState) << FlightStateFlagShift) & FlightStateFlags;
+
 	return Result;
 }
 
@@ -125,6 +279,7 @@ void UALSCharacterMovementComponent::FSavedMove_My::SetMoveFor(ACharacter* Chara
 	{
 		bSavedRequestMovementSettingsChange = CharacterMovement->bRequestMovementSettingsChange;
 		SavedAllowedGait = CharacterMovement->AllowedGait;
+		SavedFlightState = CharacterMovement->RequestedFlightState;
 	}
 }
 
@@ -138,6 +293,17 @@ void UALSCharacterMovementComponent::FSavedMove_My::PrepMoveFor(ACharacter* Char
 	}
 }
 
+bool UALSCharacterMovementComponent::FSavedMove_My::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter,
+                                                                   const float MaxDelta) const
+{
+	if (SavedFlightState != static_cast<FSavedMove_My*>(NewMove.Get())->SavedFlightState)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
 UALSCharacterMovementComponent::FNetworkPredictionData_Client_My::FNetworkPredictionData_Client_My(
 	const UCharacterMovementComponent& ClientMovement)
 	: Super(ClientMovement)
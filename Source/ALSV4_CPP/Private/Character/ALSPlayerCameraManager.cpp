@@ -5,6 +5,7 @@
 #include "Character/ALSPlayerCameraManager.h"
 
 #include "ALSStaticNames.h"
+#include "ALS_Settings.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Character/ALSPlayerController.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
@@ -23,6 +24,19 @@ AALSPlayerCameraManager::AALSPlayerCameraManager()
 	CameraBehavior->bHiddenInGame = true;
 }
 
+void AALSPlayerCameraManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Camera managers of remote players still exist on the server, but never need the camera behavior. With a camera
+	// rig preset, it is not needed at all.
+	if (CameraRigPreset || UALS_Settings::IsCosmeticFreeServer(GetWorld()))
+	{
+		CameraBehavior->SetAnimInstanceClass(nullptr);
+		CameraBehavior->SetComponentTickEnabled(false);
+	}
+}
+
 void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
 {
 	// Set "Controlled Pawn" when Player Controller Possesses new character. (called from Player Controller)
@@ -49,11 +63,19 @@ void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
 
 	ALSDebugComponent = ControlledCharacter->FindComponentByClass<UALSDebugComponent>();
 
+	UpdateCameraRig(0.0f, true);
+	ResetCameraCollision();
+
 	K2_OnPossess();
 }
 
 float AALSPlayerCameraManager::GetCameraBehaviorParam(const FName CurveName) const
 {
+	if (CameraRigPreset)
+	{
+		return CameraRigParams.GetParam(CurveName);
+	}
+
 	if (const UAnimInstance* Inst = CameraBehavior->GetAnimInstance())
 	{
 		return Inst->GetCurveValue(CurveName);
@@ -61,6 +83,66 @@ float AALSPlayerCameraManager::GetCameraBehaviorParam(const FName CurveName) con
 	return 0.0f;
 }
 
+FALSCameraRigParams AALSPlayerCameraManager::GetCameraBehaviorParams() const
+{
+	if (CameraRigPreset)
+	{
+		return CameraRigParams;
+	}
+
+	if (const UALSPlayerCameraBehavior* Behavior = Cast<UALSPlayerCameraBehavior>(CameraBehavior->GetAnimInstance()))
+	{
+		return Behavior->GetCameraParams();
+	}
+	return FALSCameraRigParams();
+}
+
+void AALSPlayerCameraManager::UpdateCameraRig(const float DeltaTime, const bool bSnap)
+{
+	if (!CameraRigPreset || !ControlledCharacter)
+	{
+		return;
+	}
+
+	const int32 State = CameraRigPreset->FindState(ControlledCharacter->GetMovementState(),
+	                                               ControlledCharacter->GetGait(),
+	                                               ControlledCharacter->GetStance(),
+	                                               ControlledCharacter->GetRotationMode(),
+	                                               ControlledCharacter->GetViewMode());
+	const bool bRightShoulder = ControlledCharacter->IsRightShoulder();
+	const bool bDebugView = ALSDebugComponent && ALSDebugComponent->GetDebugView();
+
+	if (State != CameraRigState || bRightShoulder != bCameraRigRightShoulder || bDebugView != bCameraRigDebugView)
+	{
+		// Blend on from wherever the previous blend got to.
+		CameraRigBlendStart = CameraRigParams;
+		CameraRigBlendElapsed = 0.0f;
+		CameraRigState = State;
+		bCameraRigRightShoulder = bRightShoulder;
+		bCameraRigDebugView = bDebugView;
+	}
+
+	FALSCameraRigParams Target = CameraRigPreset->GetParams(State);
+	if (CameraRigPreset->bMirrorLeftShoulder && !bRightShoulder)
+	{
+		Target.PivotOffset.Y = -Target.PivotOffset.Y;
+		Target.CameraOffset.Y = -Target.CameraOffset.Y;
+	}
+	Target.Override_Debug = bDebugView ? 1.0f : 0.0f;
+
+	const float BlendTime = CameraRigPreset->GetBlendTime(State);
+	CameraRigBlendElapsed += DeltaTime;
+
+	if (bSnap || CameraRigBlendElapsed >= BlendTime)
+	{
+		CameraRigParams = Target;
+		return;
+	}
+
+	const float Alpha = CameraRigPreset->GetBlendAlpha(State, CameraRigBlendElapsed / BlendTime);
+	CameraRigParams = FALSCameraRigParams::Lerp(CameraRigBlendStart, Target, Alpha);
+}
+
 void AALSPlayerCameraManager::UpdateViewTargetInternal(FTViewTarget& OutVT, const float DeltaTime)
 {
 	// Partially taken from base class
@@ -108,6 +190,144 @@ FVector AALSPlayerCameraManager::CalculateAxisIndependentLag(const FVector Curre
 	return CameraRotation.RotateVector(ResultVector);
 }
 
+FVector AALSPlayerCameraManager::SolveCameraCollision(const float DeltaTime, const FVector& TraceOrigin,
+                                                     const FVector& CameraLocation, const float TraceRadius,
+                                                     const ECollisionChannel TraceChannel)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	const FVector Arm = CameraLocation - TraceOrigin;
+	const float ArmLength = Arm.Size();
+	const FVector ArmDirection = ArmLength > KINDA_SMALL_NUMBER ? Arm / ArmLength : FVector::ZeroVector;
+
+	const bool bShowTraces = ALSDebugComponent && ALSDebugComponent->GetShowTraces();
+	if (bShowTraces || !IsCameraCollisionCacheValid(TraceOrigin, CameraLocation, TraceRadius, TraceChannel))
+	{
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSCameraCollision));
+		Params.AddIgnoredActor(this);
+		Params.AddIgnoredActor(ControlledCharacter);
+
+		const FCollisionShape SphereCollisionShape = FCollisionShape::MakeSphere(TraceRadius);
+
+		// The side probes run parallel to the center one, so they catch thin geometry about to slide in front of the
+		// camera before the center probe does.
+		const FVector ProbeSide = FVector::CrossProduct(FVector::UpVector, ArmDirection).GetSafeNormal() *
+			CameraCollisionProbeOffset;
+		const FVector ProbeOffsets[] = {FVector::ZeroVector, ProbeSide, -ProbeSide};
+		const int32 NumProbes = CameraCollisionProbeOffset > 0.0f ? UE_ARRAY_COUNT(ProbeOffsets) : 1;
+
+		float SafeTime = 1.0f;
+		float CenterSafeTime = 1.0f;
+		CameraCollisionHitComponents.Reset();
+
+		for (int32 i = 0; i < NumProbes; ++i)
+		{
+			const FVector Start = TraceOrigin + ProbeOffsets[i];
+			const FVector End = CameraLocation + ProbeOffsets[i];
+
+			FHitResult HitResult;
+			const bool bHit = World->SweepSingleByChannel(HitResult, Start, End, FQuat::Identity, TraceChannel,
+			                                              SphereCollisionShape, Params);
+
+			if (bShowTraces)
+			{
+				UALSDebugComponent::DrawDebugSphereTraceSingle(World,
+				                                               Start,
+				                                               End,
+				                                               SphereCollisionShape,
+				                                               EDrawDebugTrace::Type::ForOneFrame,
+				                                               bHit,
+				                                               HitResult,
+				                                               FLinearColor::Red,
+				                                               FLinearColor::Green,
+				                                               5.0f);
+			}
+
+			if (HitResult.IsValidBlockingHit())
+			{
+				SafeTime = FMath::Min(SafeTime, HitResult.Time);
+				if (i == 0)
+				{
+					CenterSafeTime = HitResult.Time;
+				}
+
+				if (UPrimitiveComponent* HitComponent = HitResult.GetComponent())
+				{
+					CameraCollisionHitComponents.Emplace(HitComponent, HitComponent->GetComponentTransform());
+				}
+			}
+		}
+
+		CameraCollisionTargetPullIn = ArmLength * (1.0f - SafeTime);
+		CameraCollisionMinPullIn = ArmLength * (1.0f - CenterSafeTime);
+		CameraCollisionOrigin = TraceOrigin;
+		CameraCollisionLocation = CameraLocation;
+		CameraCollisionRadius = TraceRadius;
+		CameraCollisionChannel = TraceChannel;
+		CameraCollisionTime = World->GetTimeSeconds();
+		bCameraCollisionCached = true;
+	}
+
+	// Pulling in is usually faster than releasing, so the camera does not sit inside geometry for long but does not
+	// spring back out the moment an obstacle clears.
+	const float InterpSpeed = CameraCollisionTargetPullIn > CameraCollisionPullIn
+		                          ? CameraCollisionPullInSpeed
+		                          : CameraCollisionReleaseSpeed;
+	CameraCollisionPullIn = FMath::FInterpTo(CameraCollisionPullIn, CameraCollisionTargetPullIn, DeltaTime,
+	                                         InterpSpeed);
+
+	// Only the pull in of the side probes is smoothed. The camera never stays behind what the center probe hit, so it
+	// can't show the inside of geometry while easing in.
+	CameraCollisionPullIn = FMath::Max(CameraCollisionPullIn, CameraCollisionMinPullIn);
+
+	return CameraLocation - ArmDirection * FMath::Min(CameraCollisionPullIn, ArmLength);
+}
+
+bool AALSPlayerCameraManager::IsCameraCollisionCacheValid(const FVector& TraceOrigin, const FVector& CameraLocation,
+                                                          const float TraceRadius,
+                                                          const ECollisionChannel TraceChannel) const
+{
+	if (!bCameraCollisionCached || CameraCollisionCacheTolerance <= 0.0f || TraceRadius != CameraCollisionRadius ||
+		TraceChannel != CameraCollisionChannel)
+	{
+		return false;
+	}
+
+	// Geometry that was not hit can still move into the probes, so the cache always expires eventually.
+	if (GetWorld()->TimeSince(CameraCollisionTime) > CameraCollisionCacheTime)
+	{
+		return false;
+	}
+
+	const float ToleranceSquared = FMath::Square(CameraCollisionCacheTolerance);
+	if (FVector::DistSquared(TraceOrigin, CameraCollisionOrigin) > ToleranceSquared ||
+		FVector::DistSquared(CameraLocation, CameraCollisionLocation) > ToleranceSquared)
+	{
+		return false;
+	}
+
+	for (const TPair<TWeakObjectPtr<UPrimitiveComponent>, FTransform>& Hit : CameraCollisionHitComponents)
+	{
+		const UPrimitiveComponent* HitComponent = Hit.Key.Get();
+		if (!HitComponent || !HitComponent->GetComponentTransform().Equals(Hit.Value))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void AALSPlayerCameraManager::ResetCameraCollision()
+{
+	bCameraCollisionCached = false;
+	CameraCollisionHitComponents.Reset();
+	CameraCollisionPullIn = 0.0f;
+	CameraCollisionTargetPullIn = 0.0f;
+	CameraCollisionMinPullIn = 0.0f;
+}
+
 bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Location, FRotator& Rotation, float& FOV)
 {
 	if (!ControlledCharacter)
@@ -116,6 +336,9 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 		return false;
 	}
 
+	UpdateCameraRig(DeltaTime);
+	const FALSCameraRigParams RigParams = GetCameraBehaviorParams();
+
 	// Step 1: Get Camera Parameters from CharacterBP via the Camera Interface
 	const FTransform& PivotTarget = ControlledCharacter->GetThirdPersonPivotTarget();
 	const FVector& FPTarget = ControlledCharacter->GetFirstPersonCameraTarget();
@@ -127,20 +350,15 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	// Step 2: Calculate Target Camera Rotation. Use the Control Rotation and interpolate for smooth camera rotation.
 	const FRotator& InterpResult = FMath::RInterpTo(GetCameraRotation(),
 	                                                GetOwningPlayerController()->GetControlRotation(), DeltaTime,
-	                                                GetCameraBehaviorParam(NAME_RotationLagSpeed));
+	                                                RigParams.RotationLagSpeed);
 
-	TargetCameraRotation = UKismetMathLibrary::RLerp(InterpResult, DebugViewRotation,
-	                                                 GetCameraBehaviorParam(TEXT("Override_Debug")), true);
+	TargetCameraRotation = UKismetMathLibrary::RLerp(InterpResult, DebugViewRotation, RigParams.Override_Debug, true);
 
 	// Step 3: Calculate the Smoothed Pivot Target (Orange Sphere).
 	// Get the 3P Pivot Target (Green Sphere) and interpolate using axis independent lag for maximum control.
-	const FVector LagSpd(GetCameraBehaviorParam(NAME_PivotLagSpeed_X),
-	                     GetCameraBehaviorParam(NAME_PivotLagSpeed_Y),
-	                     GetCameraBehaviorParam(NAME_PivotLagSpeed_Z));
-
 	const FVector& AxisIndpLag = CalculateAxisIndependentLag(SmoothedPivotTarget.GetLocation(),
-	                                                         PivotTarget.GetLocation(), TargetCameraRotation, LagSpd,
-	                                                         DeltaTime);
+	                                                         PivotTarget.GetLocation(), TargetCameraRotation,
+	                                                         RigParams.PivotLagSpeed, DeltaTime);
 
 	SmoothedPivotTarget.SetRotation(PivotTarget.GetRotation());
 	SmoothedPivotTarget.SetLocation(AxisIndpLag);
@@ -150,79 +368,44 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	// Pivot Target and apply local offsets for further camera control.
 	PivotLocation =
 		SmoothedPivotTarget.GetLocation() +
-		UKismetMathLibrary::GetForwardVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			NAME_PivotOffset_X) +
-		UKismetMathLibrary::GetRightVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			NAME_PivotOffset_Y) +
-		UKismetMathLibrary::GetUpVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			NAME_PivotOffset_Z);
+		UKismetMathLibrary::GetForwardVector(SmoothedPivotTarget.Rotator()) * RigParams.PivotOffset.X +
+		UKismetMathLibrary::GetRightVector(SmoothedPivotTarget.Rotator()) * RigParams.PivotOffset.Y +
+		UKismetMathLibrary::GetUpVector(SmoothedPivotTarget.Rotator()) * RigParams.PivotOffset.Z;
 
 	// Step 5: Calculate Target Camera Location. Get the Pivot location and apply camera relative offsets.
 	TargetCameraLocation = UKismetMathLibrary::VLerp(
 		PivotLocation +
-		UKismetMathLibrary::GetForwardVector(TargetCameraRotation) * GetCameraBehaviorParam(
-			NAME_CameraOffset_X) +
-		UKismetMathLibrary::GetRightVector(TargetCameraRotation) * GetCameraBehaviorParam(NAME_CameraOffset_Y)
-		+
-		UKismetMathLibrary::GetUpVector(TargetCameraRotation) * GetCameraBehaviorParam(NAME_CameraOffset_Z),
+		UKismetMathLibrary::GetForwardVector(TargetCameraRotation) * RigParams.CameraOffset.X +
+		UKismetMathLibrary::GetRightVector(TargetCameraRotation) * RigParams.CameraOffset.Y +
+		UKismetMathLibrary::GetUpVector(TargetCameraRotation) * RigParams.CameraOffset.Z,
 		PivotTarget.GetLocation() + DebugViewOffset,
-		GetCameraBehaviorParam(NAME_Override_Debug));
+		RigParams.Override_Debug);
 
 	// Step 6: Trace for an object between the camera and character to apply a corrective offset.
 	// Trace origins are set within the Character BP via the Camera Interface.
 	// Functions like the normal spring arm, but can allow for different trace origins regardless of the pivot
 	FVector TraceOrigin;
 	float TraceRadius;
-	ECollisionChannel TraceChannel = ControlledCharacter->GetThirdPersonTraceParams(TraceOrigin, TraceRadius);
-
-	UWorld* World = GetWorld();
-	check(World);
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-	Params.AddIgnoredActor(ControlledCharacter);
+	const ECollisionChannel TraceChannel = ControlledCharacter->GetThirdPersonTraceParams(TraceOrigin, TraceRadius);
 
-	FHitResult HitResult;
-	const FCollisionShape SphereCollisionShape = FCollisionShape::MakeSphere(TraceRadius);
-	const bool bHit = World->SweepSingleByChannel(HitResult, TraceOrigin, TargetCameraLocation, FQuat::Identity,
-	                                              TraceChannel, SphereCollisionShape, Params);
-
-	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
-	{
-		UALSDebugComponent::DrawDebugSphereTraceSingle(World,
-		                                               TraceOrigin,
-		                                               TargetCameraLocation,
-		                                               SphereCollisionShape,
-		                                               EDrawDebugTrace::Type::ForOneFrame,
-		                                               bHit,
-		                                               HitResult,
-		                                               FLinearColor::Red,
-		                                               FLinearColor::Green,
-		                                               5.0f);
-	}
-
-	if (HitResult.IsValidBlockingHit())
-	{
-		TargetCameraLocation += HitResult.Location - HitResult.TraceEnd;
-	}
+	TargetCameraLocation = SolveCameraCollision(DeltaTime, TraceOrigin, TargetCameraLocation, TraceRadius,
+	                                            TraceChannel);
 
 	// Step 8: Lerp First Person Override and return target camera parameters.
 	FTransform TargetCameraTransform(TargetCameraRotation, TargetCameraLocation, FVector::OneVector);
 	FTransform FPTargetCameraTransform(TargetCameraRotation, FPTarget, FVector::OneVector);
 
 	const FTransform& MixedTransform = UKismetMathLibrary::TLerp(TargetCameraTransform, FPTargetCameraTransform,
-	                                                             GetCameraBehaviorParam(
-		                                                             NAME_Weight_FirstPerson));
+	                                                             RigParams.Weight_FirstPerson);
 
 	const FTransform& TargetTransform = UKismetMathLibrary::TLerp(MixedTransform,
 	                                                              FTransform(DebugViewRotation, TargetCameraLocation,
 	                                                                         FVector::OneVector),
-	                                                              GetCameraBehaviorParam(
-		                                                              NAME_Override_Debug));
+	                                                              RigParams.Override_Debug);
 
 	Location = TargetTransform.GetLocation();
 	Rotation = TargetTransform.Rotator();
-	FOV = FMath::Lerp(TPFOV, FPFOV, GetCameraBehaviorParam(NAME_Weight_FirstPerson));
+	FOV = FMath::Lerp(TPFOV, FPFOV, RigParams.Weight_FirstPerson);
 
 	return true;
 }
\ No newline at end of file
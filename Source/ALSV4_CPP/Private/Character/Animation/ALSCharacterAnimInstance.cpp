@@ -5,6 +5,7 @@
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 
 #include "ALSStaticNames.h"
+#include "ALS_Settings.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Library/ALSMathLibrary.h"
 #include "Components/ALSDebugComponent.h"
@@ -34,6 +35,8 @@ void UALSCharacterAnimInstance::NativeBeginPlay()
 	{
 		ALSDebugComponent = Owner->FindComponentByClass<UALSDebugComponent>();
 	}
+
+	bCosmeticFree = UALS_Settings::IsCosmeticFreeServer(GetWorld());
 }
 
 void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
@@ -68,9 +71,14 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
 	OverlayState = Character->GetOverlayState();
 	GroundedEntryState = Character->GetGroundedEntryState();
 
+	// Aiming values are needed by the turn in place checks, so always update them.
 	UpdateAimingValues(DeltaSeconds);
-	UpdateLayerValues();
-	UpdateFootIK(DeltaSeconds);
+
+	if (!bCosmeticFree)
+	{
+		UpdateLayerValues();
+		UpdateFootIK(DeltaSeconds);
+	}
 
 	if (MovementState.Grounded())
 	{
@@ -88,7 +96,8 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
 
 		if (Grounded.bShouldMove)
 		{
-			// Do While Moving
+			// Do While Moving. Also on cosmetic free servers: the yaw offsets drive the YawOffset curve that
+			// grounded rotation reads, and the blend values pick the poses the other gameplay curves come from.
 			UpdateMovementValues(DeltaSeconds);
 			UpdateRotationValues();
 		}
@@ -112,7 +121,7 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
 			{
 				TurnInPlaceValues.ElapsedDelayTime = 0.0f;
 			}
-			if (CanDynamicTransition())
+			if (!bCosmeticFree && CanDynamicTransition())
 			{
 				DynamicTransitionCheck();
 			}
@@ -123,7 +132,7 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(const float DeltaSeconds)
 		// Do While InAir
 		UpdateInAirValues(DeltaSeconds);
 	}
-	else if (MovementState.Ragdoll())
+	else if (MovementState.Ragdoll() && !bCosmeticFree)
 	{
 		// Do While Ragdolling
 		UpdateRagdollValues();
@@ -640,6 +649,11 @@ void UALSCharacterAnimInstance::UpdateInAirValues(const float DeltaSeconds)
 	// If not, the Z velocity would return to 0 on landing.
 	InAir.FallSpeed = CharacterInformation.Velocity.Z;
 
+	if (bCosmeticFree)
+	{
+		return;
+	}
+
 	// Set the Land Prediction weight.
 	InAir.LandPrediction = CalculateLandPrediction();
 
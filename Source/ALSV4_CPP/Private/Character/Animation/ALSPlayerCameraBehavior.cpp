@@ -5,8 +5,30 @@
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
 
 
+#include "ALSStaticNames.h"
 #include "Character/ALSBaseCharacter.h"
 
+using namespace ALS::CameraManager;
+
+void UALSPlayerCameraBehavior::NativePostEvaluateAnimation()
+{
+	Super::NativePostEvaluateAnimation();
+
+	// Looked up once per evaluation instead of once per read.
+	CameraParams.RotationLagSpeed = GetCurveValue(NAME_RotationLagSpeed);
+	CameraParams.PivotLagSpeed = FVector(GetCurveValue(NAME_PivotLagSpeed_X),
+	                                     GetCurveValue(NAME_PivotLagSpeed_Y),
+	                                     GetCurveValue(NAME_PivotLagSpeed_Z));
+	CameraParams.PivotOffset = FVector(GetCurveValue(NAME_PivotOffset_X),
+	                                   GetCurveValue(NAME_PivotOffset_Y),
+	                                   GetCurveValue(NAME_PivotOffset_Z));
+	CameraParams.CameraOffset = FVector(GetCurveValue(NAME_CameraOffset_X),
+	                                    GetCurveValue(NAME_CameraOffset_Y),
+	                                    GetCurveValue(NAME_CameraOffset_Z));
+	CameraParams.Weight_FirstPerson = GetCurveValue(NAME_Weight_FirstPerson);
+	CameraParams.Override_Debug = GetCurveValue(NAME_Override_Debug);
+}
+
 void UALSPlayerCameraBehavior::SetRotationMode(const EALSRotationMode RotationMode)
 {
 	bVelocityDirection = RotationMode == EALSRotationMode::VelocityDirection;
@@ -6,13 +6,92 @@
 
 #include "ALSStaticNames.h"
 #include "Components/AudioComponent.h"
+#include "Containers/StaticArray.h"
 #include "Engine/DataTable.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Subsystems/ALSHitFXPreloadSubsystem.h"
 #include "NiagaraSystem.h"
 #include "NiagaraFunctionLibrary.h"
 
+namespace ALS::Footstep
+{
+	// Rows of a hit FX table by surface type, with the default row already filled in for surfaces without their own.
+	struct FHitFXCache
+	{
+		TStaticArray<const FALSHitFX*, SurfaceType_Max> Rows;
+
+		FDelegateHandle ChangedHandle;
+	};
+
+	static TMap<TWeakObjectPtr<UDataTable>, FHitFXCache> HitFXCaches;
+
+	static const FALSHitFX* FindHitFX(UDataTable* DataTable, const EPhysicalSurface SurfaceType)
+	{
+		check(IsInGameThread());
+
+		if (const FHitFXCache* Cache = HitFXCaches.Find(DataTable))
+		{
+			return Cache->Rows[SurfaceType];
+		}
+
+		// Tables that were destroyed can't notify a change, so drop their caches here.
+		for (auto It = HitFXCaches.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		TArray<FALSHitFX*> HitFXRows;
+		DataTable->GetAllRows<FALSHitFX>(FString(), HitFXRows);
+
+		FHitFXCache& Cache = HitFXCaches.Add(DataTable);
+		for (int32 i = 0; i < SurfaceType_Max; ++i)
+		{
+			Cache.Rows[i] = nullptr;
+		}
+
+		// The first row of a surface wins, as with the linear search this replaces.
+		for (const FALSHitFX* Row : HitFXRows)
+		{
+			if (!Cache.Rows[Row->SurfaceType])
+			{
+				Cache.Rows[Row->SurfaceType] = Row;
+			}
+		}
+
+		if (const FALSHitFX* DefaultRow = Cache.Rows[SurfaceType_Default])
+		{
+			for (int32 i = 0; i < SurfaceType_Max; ++i)
+			{
+				if (!Cache.Rows[i])
+				{
+					Cache.Rows[i] = DefaultRow;
+				}
+			}
+		}
+
+		// Editing or reimporting the table moves its rows.
+		const TWeakObjectPtr<UDataTable> WeakDataTable(DataTable);
+		Cache.ChangedHandle = DataTable->OnDataTableChanged().AddLambda([WeakDataTable]()
+		{
+			if (UDataTable* ChangedTable = WeakDataTable.Get())
+			{
+				if (const FHitFXCache* ChangedCache = HitFXCaches.Find(WeakDataTable))
+				{
+					ChangedTable->OnDataTableChanged().Remove(ChangedCache->ChangedHandle);
+				}
+			}
+			HitFXCaches.Remove(WeakDataTable);
+		});
+
+		return Cache.Rows[SurfaceType];
+	}
+}
+
 using namespace ALS::Footstep;
 
 UALSAnimNotifyFootstep::UALSAnimNotifyFootstep()
@@ -57,34 +136,27 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 
 			const EPhysicalSurface SurfaceType = Hit.PhysMaterial.Get()->SurfaceType;
 
-			check(IsInGameThread());
-			checkNoRecursion();
-			static TArray<FALSHitFX*> HitFXRows;
-			HitFXRows.Reset();
-
-			HitDataTable->GetAllRows<FALSHitFX>(FString(), HitFXRows);
-
-			FALSHitFX* HitFX = nullptr;
-			if (auto FoundResult = HitFXRows.FindByPredicate([&](const FALSHitFX* Value)
-			{
-				return SurfaceType == Value->SurfaceType;
-			}))
+			const FALSHitFX* HitFX = FindHitFX(HitDataTable, SurfaceType);
+			if (!HitFX)
 			{
-				HitFX = *FoundResult;
+				return;
 			}
-			else if (auto DefaultResult = HitFXRows.FindByPredicate([&](const FALSHitFX* Value)
-			{
-				return EPhysicalSurface::SurfaceType_Default == Value->SurfaceType;
-			}))
+
+			// Assets still streaming in are skipped for this step. Without the preloader, e.g. in animation editor
+			// previews, they are loaded synchronously as before.
+			UALSHitFXPreloadSubsystem* Preloader = World->GetSubsystem<UALSHitFXPreloadSubsystem>();
+			if (Preloader)
 			{
-				HitFX = *DefaultResult;
+				Preloader->PreloadHitFX(HitDataTable);
 			}
-			else
+
+			auto GetAsset = [Preloader](const auto& Asset)
 			{
-				return;
-			}
+				return Preloader ? Preloader->GetOrRequestAsset(Asset) : Asset.LoadSynchronous();
+			};
 
-			if (bSpawnSound && HitFX->Sound.LoadSynchronous())
+			USoundBase* Sound = bSpawnSound ? GetAsset(HitFX->Sound) : nullptr;
+			if (Sound)
 			{
 				UAudioComponent* SpawnedSound = nullptr;
 
@@ -98,12 +170,12 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 				{
 				case EALSSpawnType::Location:
 					SpawnedSound = UGameplayStatics::SpawnSoundAtLocation(
-						World, HitFX->Sound.Get(), Hit.Location + HitFX->SoundLocationOffset,
+						World, Sound, Hit.Location + HitFX->SoundLocationOffset,
 						HitFX->SoundRotationOffset, FinalVolMult, PitchMultiplier);
 					break;
 
 				case EALSSpawnType::Attached:
-					SpawnedSound = UGameplayStatics::SpawnSoundAttached(HitFX->Sound.Get(), MeshComp, FootSocketName,
+					SpawnedSound = UGameplayStatics::SpawnSoundAttached(Sound, MeshComp, FootSocketName,
 					                                                    HitFX->SoundLocationOffset,
 					                                                    HitFX->SoundRotationOffset,
 					                                                    HitFX->SoundAttachmentType, true, FinalVolMult,
@@ -117,7 +189,8 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 				}
 			}
 
-			if (bSpawnNiagara && HitFX->NiagaraSystem.LoadSynchronous())
+			UNiagaraSystem* NiagaraSystem = bSpawnNiagara ? GetAsset(HitFX->NiagaraSystem) : nullptr;
+			if (NiagaraSystem)
 			{
 				UNiagaraComponent* SpawnedParticle = nullptr;
 				const FVector Location = Hit.Location + MeshOwner->GetTransform().TransformVector(
@@ -127,18 +200,19 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 				{
 				case EALSSpawnType::Location:
 					SpawnedParticle = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
-						World, HitFX->NiagaraSystem.Get(), Location, FootRotation + HitFX->NiagaraRotationOffset);
+						World, NiagaraSystem, Location, FootRotation + HitFX->NiagaraRotationOffset);
 					break;
 
 				case EALSSpawnType::Attached:
 					SpawnedParticle = UNiagaraFunctionLibrary::SpawnSystemAttached(
-						HitFX->NiagaraSystem.Get(), MeshComp, FootSocketName, HitFX->NiagaraLocationOffset,
+						NiagaraSystem, MeshComp, FootSocketName, HitFX->NiagaraLocationOffset,
 						HitFX->NiagaraRotationOffset, HitFX->NiagaraAttachmentType, true);
 					break;
 				}
 			}
 
-			if (bSpawnDecal && HitFX->DecalMaterial.LoadSynchronous())
+			UMaterialInterface* DecalMaterial = bSpawnDecal ? GetAsset(HitFX->DecalMaterial) : nullptr;
+			if (DecalMaterial)
 			{
 				const FVector Location = Hit.Location + MeshOwner->GetTransform().TransformVector(
 					HitFX->DecalLocationOffset);
@@ -152,12 +226,12 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 				{
 				case EALSSpawnType::Location:
 					SpawnedDecal = UGameplayStatics::SpawnDecalAtLocation(
-						World, HitFX->DecalMaterial.Get(), DecalSize, Location,
+						World, DecalMaterial, DecalSize, Location,
 						FootRotation + HitFX->DecalRotationOffset, HitFX->DecalLifeSpan);
 					break;
 
 				case EALSSpawnType::Attached:
-					SpawnedDecal = UGameplayStatics::SpawnDecalAttached(HitFX->DecalMaterial.Get(), DecalSize,
+					SpawnedDecal = UGameplayStatics::SpawnDecalAttached(DecalMaterial, DecalSize,
 					                                                    Hit.Component.Get(), NAME_None, Location,
 					                                                    FootRotation + HitFX->DecalRotationOffset,
 					                                                    HitFX->DecalAttachmentType,
@@ -0,0 +1,270 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Commandlets/ALSLedgeBakeCommandlet.h"
+
+#include "ALS_Settings.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Subsystems/ALSLedgeSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAlsLedgeBake, Log, All)
+
+namespace ALS::LedgeBake
+{
+	// Stops tracing down a column after this many hits.
+	static constexpr int32 MaxHitsPerColumn = 256;
+
+	static const FIntPoint Directions[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+}
+
+using namespace ALS::LedgeBake;
+
+UALSLedgeBakeCommandlet::UALSLedgeBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UALSLedgeBakeCommandlet::Main(const FString& Params)
+{
+	FParse::Value(*Params, TEXT("Spacing="), Spacing);
+	FParse::Value(*Params, TEXT("MinHeight="), MinLedgeHeight);
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	Spacing = FMath::Max(Spacing, 1.0f);
+	CellSize = FMath::Max(CellSize, Spacing);
+
+	TArray<FString> Maps;
+	FString MapsParam;
+	if (FParse::Value(*Params, TEXT("Maps="), MapsParam))
+	{
+		MapsParam.ParseIntoArray(Maps, TEXT("+"));
+	}
+	else
+	{
+		TArray<FString> Files;
+		FPackageName::FindPackagesInDirectory(Files, FPaths::ProjectContentDir());
+		for (const FString& File : Files)
+		{
+			FString PackageName;
+			if (FPaths::GetExtension(File, true) == FPackageName::GetMapPackageExtension() &&
+				FPackageName::TryConvertFilenameToLongPackageName(File, PackageName))
+			{
+				Maps.Add(PackageName);
+			}
+		}
+	}
+
+	int32 NumFailed = 0;
+	for (const FString& Map : Maps)
+	{
+		if (!BakeLevel(Map))
+		{
+			NumFailed++;
+		}
+	}
+
+	return NumFailed > 0 ? 1 : 0;
+}
+
+bool UALSLedgeBakeCommandlet::BakeLevel(const FString& PackageName) const
+{
+	UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogAlsLedgeBake, Error, TEXT("Could not load map %s"), *PackageName);
+		return false;
+	}
+
+	// Only collision is needed for tracing.
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+		                 .RequiresHitProxies(false)
+		                 .ShouldSimulatePhysics(false)
+		                 .EnableTraceCollision(true)
+		                 .CreateNavigation(false)
+		                 .CreateAISystem(false)
+		                 .AllowAudioPlayback(false)
+		                 .CreatePhysicsScene(true));
+	}
+	World->UpdateWorldComponents(true, false);
+
+	FALSLedgeDatabase Database;
+	BakeWorld(World, Database);
+
+	const FString FilePath = FALSLedgeDatabase::GetFilePath(PackageName);
+	const bool bSaved = Database.Save(FilePath);
+	if (bSaved)
+	{
+		UE_LOG(LogAlsLedgeBake, Display, TEXT("Baked %d ledges of %s to %s"), Database.Ledges.Num(), *PackageName,
+		       *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogAlsLedgeBake, Error, TEXT("Could not write %s"), *FilePath);
+	}
+
+	World->RemoveFromRoot();
+	World->CleanupWorld();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return bSaved;
+}
+
+void UALSLedgeBakeCommandlet::BakeWorld(UWorld* World, FALSLedgeDatabase& OutDatabase) const
+{
+	const ECollisionChannel Channel = UALS_Settings::Get()->MantleCheckChannel;
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSLedgeBake));
+	Params.MobilityType = EQueryMobilityType::Static;
+
+	// Step 1: Bound the static geometry of the level.
+	FBox Bounds(ForceInit);
+	for (const AActor* Actor : World->PersistentLevel->Actors)
+	{
+		if (!Actor)
+		{
+			continue;
+		}
+
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [&](const UPrimitiveComponent* Component)
+		{
+			if (Component->Mobility == EComponentMobility::Static && Component->IsCollisionEnabled() &&
+				Component->GetCollisionResponseToChannel(Channel) == ECR_Block)
+			{
+				Bounds += Component->Bounds.GetBox();
+			}
+		});
+	}
+
+	OutDatabase.Bounds = Bounds;
+	OutDatabase.CellSize = CellSize;
+	OutDatabase.Spacing = Spacing;
+
+	if (!Bounds.IsValid)
+	{
+		return;
+	}
+
+	// Step 2: Trace down every column to find all walkable surfaces, top to bottom.
+	struct FSurface
+	{
+		float Z;
+		int32 Component;
+	};
+
+	TMap<FIntPoint, TArray<FSurface>> Columns;
+	TMap<const UPrimitiveComponent*, int32> ComponentIndices;
+
+	const int32 MinX = FMath::FloorToInt(Bounds.Min.X / Spacing);
+	const int32 MinY = FMath::FloorToInt(Bounds.Min.Y / Spacing);
+	const int32 MaxX = FMath::FloorToInt(Bounds.Max.X / Spacing);
+	const int32 MaxY = FMath::FloorToInt(Bounds.Max.Y / Spacing);
+
+	for (int32 X = MinX; X <= MaxX; ++X)
+	{
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			const FVector2D ColumnCenter = FVector2D(X + 0.5f, Y + 0.5f) * Spacing;
+			FVector Start(ColumnCenter, Bounds.Max.Z + 1.0f);
+			const FVector End(ColumnCenter, Bounds.Min.Z - 1.0f);
+
+			TArray<FSurface> Surfaces;
+			for (int32 i = 0; i < MaxHitsPerColumn && Start.Z > End.Z; ++i)
+			{
+				FHitResult Hit;
+				if (!World->LineTraceSingleByChannel(Hit, Start, End, Channel, Params))
+				{
+					break;
+				}
+
+				const UPrimitiveComponent* Component = Hit.GetComponent();
+				if (!Hit.bStartPenetrating && Component && Hit.ImpactNormal.Z >= WalkableFloorZ)
+				{
+					int32& ComponentIndex = ComponentIndices.FindOrAdd(Component, INDEX_NONE);
+					if (ComponentIndex == INDEX_NONE)
+					{
+						ComponentIndex = OutDatabase.ComponentPaths.Add(Component->GetPathName());
+					}
+					Surfaces.Add({static_cast<float>(Hit.ImpactPoint.Z), ComponentIndex});
+				}
+
+				// Continue below, stepping through the inside of the geometry that was hit. Surfaces closer together
+				// than this can't form a ledge anyway.
+				Start.Z = (Hit.bStartPenetrating ? Start.Z : Hit.ImpactPoint.Z) - MinLedgeHeight * 0.5f;
+			}
+
+			// The line through the center misses railings, fences and thin walls between two centers. A sweep
+			// covering the whole column finds the top of anything in it.
+			FHitResult TopHit;
+			const FVector TopStart(ColumnCenter, Bounds.Max.Z + Spacing);
+			if (World->SweepSingleByChannel(TopHit, TopStart, End, FQuat::Identity, Channel,
+			                                FCollisionShape::MakeSphere(Spacing * HALF_SQRT_2), Params) &&
+				!TopHit.bStartPenetrating && TopHit.GetComponent() && TopHit.ImpactNormal.Z >= WalkableFloorZ &&
+				(Surfaces.IsEmpty() || TopHit.ImpactPoint.Z >= Surfaces[0].Z + MinLedgeHeight * 0.5f))
+			{
+				const UPrimitiveComponent* Component = TopHit.GetComponent();
+				int32& ComponentIndex = ComponentIndices.FindOrAdd(Component, INDEX_NONE);
+				if (ComponentIndex == INDEX_NONE)
+				{
+					ComponentIndex = OutDatabase.ComponentPaths.Add(Component->GetPathName());
+				}
+				Surfaces.Insert({static_cast<float>(TopHit.ImpactPoint.Z), ComponentIndex}, 0);
+			}
+
+			if (!Surfaces.IsEmpty())
+			{
+				Columns.Add(FIntPoint(X, Y), MoveTemp(Surfaces));
+			}
+		}
+	}
+
+	// Step 3: A surface is a ledge towards a neighboring column, if the neighbor has no surface about as high. The
+	// drop to the next surface below is stored, but not limited: mantle checks are relative to the capsule, which may
+	// be falling past the ledge, not to the ground in front of it.
+	for (const TPair<FIntPoint, TArray<FSurface>>& Column : Columns)
+	{
+		for (const FSurface& Surface : Column.Value)
+		{
+			for (const FIntPoint& Direction : Directions)
+			{
+				// Nothing below in the neighbor drops to the bottom of the baked area.
+				float Height = Surface.Z - Bounds.Min.Z;
+				static const TArray<FSurface> NoSurfaces;
+				const TArray<FSurface>* Neighbor = Columns.Find(Column.Key + Direction);
+				for (const FSurface& Lower : Neighbor ? *Neighbor : NoSurfaces)
+				{
+					if (Lower.Z <= Surface.Z + MinLedgeHeight)
+					{
+						Height = Surface.Z - Lower.Z;
+						break;
+					}
+				}
+
+				if (Height < MinLedgeHeight)
+				{
+					continue;
+				}
+
+				const FVector2D Edge = FVector2D(Column.Key.X + 0.5f + Direction.X * 0.5f,
+				                                 Column.Key.Y + 0.5f + Direction.Y * 0.5f) * Spacing;
+
+				FALSLedge& Ledge = OutDatabase.Ledges.AddDefaulted_GetRef();
+				Ledge.Location = FVector3f(Edge.X, Edge.Y, Surface.Z);
+				Ledge.Normal = FVector3f(Direction.X, Direction.Y, 0.0f);
+				Ledge.Height = Height;
+				Ledge.Component = Surface.Component;
+			}
+		}
+	}
+
+	OutDatabase.SortLedges();
+}
@@ -4,6 +4,7 @@
 #include "Components/ALSDebugComponent.h"
 
 
+#include "ALS_Settings.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Character/ALSPlayerCameraManager.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
@@ -117,6 +118,14 @@ void UALSDebugComponent::BeginPlay()
 
 	OwnerCharacter = Cast<AALSBaseCharacter>(GetOwner());
 	DebugFocusCharacter = OwnerCharacter;
+
+	// Nothing to debug visually on a cosmetic free server.
+	if (UALS_Settings::IsCosmeticFreeServer(GetWorld()))
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
 	if (OwnerCharacter)
 	{
 		SetDynamicMaterials();
@@ -8,6 +8,8 @@
 #include "Components/ALSDebugComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Net/UnrealNetwork.h"
+#include "Subsystems/ALSAltitudeSubsystem.h"
 
 static bool ALSDebugFlightTraces = false;
 FAutoConsoleVariableRef CVarALSDebugFlight(TEXT("ALS.Debug.FlightTraces"), ALSDebugFlightTraces, TEXT("Show debug flight traces"));
@@ -15,10 +17,15 @@ FAutoConsoleVariableRef CVarALSDebugFlight(TEXT("ALS.Debug.FlightTraces"), ALSDe
 UALSFlightComponent::UALSFlightComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UALSFlightComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	const UALS_Settings* UALS_Settings = UALS_Settings::Get();
-	SeaAltitude = UALS_Settings->SeaAltitude;
-	TroposphereHeight = UALS_Settings->TroposphereHeight;
+	DOREPLIFETIME(UALSFlightComponent, WeightRatio);
+	DOREPLIFETIME(UALSFlightComponent, Temperature);
 }
 
 void UALSFlightComponent::BeginPlay()
@@ -31,27 +38,14 @@ void UALSFlightComponent::BeginPlay()
 		if (IsValid(OwnerCharacter))
 		{
 			ALSDebugComponent = OwnerCharacter->FindComponentByClass<UALSDebugComponent>();
-
-			// @TODO flight catching should really be in the movement state machine not in the flight component.
-			OwnerCharacter->MovementModeChangedDelegate.AddDynamic(this, &UALSFlightComponent::OnOwningMovementModeChanged);
+			AltitudeSubsystem = GetWorld()->GetSubsystem<UALSAltitudeSubsystem>();
+			AtmosphereSubsystem = GetWorld()->GetSubsystem<UALSAtmosphereSubsystem>();
 
 			OwnerCharacter->OnActorHit.AddDynamic(this, &UALSFlightComponent::OnActorHit);
 		}
 	}
 }
 
-// @TODO flight catching should really be in the movement state machine not in the flight component.
-
-// ReSharper disable once CppParameterMayBeConstPtrOrRef
-void UALSFlightComponent::OnOwningMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode,
-                                                      uint8 PreviousCustomMode)
-{
-	if (Character->GetCharacterMovement()->IsFalling())
-	{
-		TimeStartingFalling = FDateTime::Now();
-	}
-}
-
 // ReSharper disable once CppMemberFunctionMayBeConst
 void UALSFlightComponent::OnActorHit(AActor* SelfActor, AActor* OtherActor, const FVector NormalImpulse,
                                      const FHitResult& Hit)
@@ -68,14 +62,80 @@ void UALSFlightComponent::OnActorHit(AActor* SelfActor, AActor* OtherActor, cons
 
 void UALSFlightComponent::UpdateFlight(const float DeltaTime)
 {
-	RelativeAltitude = FlightDistanceCheck(TroposphereHeight, FVector::DownVector);
+	UpdateRelativeAltitude();
+
+	if (AtmosphereSubsystem)
+	{
+		Atmosphere = AtmosphereSubsystem->Sample(OwnerCharacter->GetActorLocation());
+	}
+
+	// The server enforces no-fly zones as well, see CanFly.
+	if (Atmosphere.bNoFly && GetOwnerRole() != ROLE_SimulatedProxy)
+	{
+		OwnerCharacter->SetFlightState(EALSFlightState::None);
+		return;
+	}
+
+	// Flight state changes are predicted by the owner and sent to the server with its moves.
+	if (AlwaysCheckFlightConditions && OwnerCharacter->IsLocallyControlled() && !CanFly())
+	{
+		OwnerCharacter->SetFlightState(EALSFlightState::None);
+		return;
+	}
 
 	UpdateFlightRotation(DeltaTime);
+}
 
-	if (OwnerCharacter->HasAuthority() || GetOwnerRole() == ROLE_AutonomousProxy)
+void UALSFlightComponent::UpdateRelativeAltitude()
+{
+	// Only trace when the cached ground height says we are close to the ground.
+	if (AltitudeSubsystem)
 	{
-		UpdateFlightMovement(DeltaTime);
+		const FVector Bottom = OwnerCharacter->GetActorLocation() - FVector{0, 0,
+			OwnerCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()};
+		const float CoarseAltitude = AltitudeSubsystem->GetCoarseAltitude(Bottom);
+		if (CoarseAltitude > ExactAltitudeCheckDistance)
+		{
+			RelativeAltitude = FMath::Min(CoarseAltitude, GetMaxAltitude());
+			return;
+		}
+	}
+
+	RelativeAltitude = FlightDistanceCheck(ExactAltitudeCheckDistance, FVector::DownVector);
+}
+
+float UALSFlightComponent::SampleGroundProximity(const FVector& Bottom, const FVector& Velocity) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return 0.f;
+
+	// Most of the flight is far from any surface, where a single overlap test replaces the whole fan.
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(OwnerCharacter);
+	if (!World->OverlapAnyTestByChannel(Bottom, FQuat::Identity, UALS_Settings::Get()->FlightCheckChannel,
+	                                    FCollisionShape::MakeSphere(GroundEffectHeight), Params))
+	{
+		return 0.f;
+	}
+
+	// The rays fan out around the downwash. Rays off the center pick up slopes and walls next to the character.
+	const FVector PressureDirection = GetDownwashDirection(Velocity);
+	const FQuat FanRotation = FRotationMatrix::MakeFromX(PressureDirection).ToQuat();
+	const float FanAngle = FMath::DegreesToRadians(GroundEffectFanAngle);
+	const int32 RayCount = FMath::Max(GroundEffectRayCount, 1);
+
+	// The closest surface in any direction decides.
+	float ClosestDistance = TraceFlightDistance(Bottom, GroundEffectHeight, PressureDirection);
+	for (int32 Ray = 1; Ray < RayCount; ++Ray)
+	{
+		const float Azimuth = 2.0f * PI * (Ray - 1) / (RayCount - 1);
+		const FVector Direction = FanRotation.RotateVector(FVector(FMath::Cos(FanAngle),
+		                                                           FMath::Sin(FanAngle) * FMath::Cos(Azimuth),
+		                                                           FMath::Sin(FanAngle) * FMath::Sin(Azimuth)));
+		ClosestDistance = FMath::Min(ClosestDistance, TraceFlightDistance(Bottom, ClosestDistance, Direction));
 	}
+
+	return 1.0f - ClosestDistance / GroundEffectHeight;
 }
 
 void UALSFlightComponent::UpdateFlightRotation(const float DeltaTime)
@@ -158,92 +218,99 @@ float UALSFlightComponent::CalculateFlightRotationRate() const
 	return CurveVal * ClampedAimYawRate;
 }
 
-void UALSFlightComponent::UpdateFlightMovement(const float DeltaTime)
+float UALSFlightComponent::GetMaxAltitude() const
 {
-	if (AlwaysCheckFlightConditions)
+	return AtmosphereSubsystem ? AtmosphereSubsystem->GetTroposphereHeight() : UALS_Settings::Get()->TroposphereHeight;
+}
+
+FALSAeroInputs UALSFlightComponent::MakeAeroInputsAt(const EALSFlightState State, const FVector& Velocity,
+                                                     const float Density, const float InGroundProximity) const
+{
+	FALSAeroInputs Inputs;
+
+	switch (State)
 	{
-		if (!CanFly())
-		{
-			OwnerCharacter->SetFlightState(EALSFlightState::None);
-			return;
-		}
+	case EALSFlightState::Hovering:
+		// Wings beat to hold the character in place.
+		Inputs.BaseLift = HoverLiftRatio;
+		break;
+	case EALSFlightState::Aerial:
+		// Gliding wings only carry the full weight at speed.
+		Inputs.BaseLift = MinGlideLiftRatio;
+		Inputs.SpeedLift = 1.0f - MinGlideLiftRatio;
+		break;
+	default: break;
 	}
 
-	// The rest of this function calculates the auto-hover strength. This is how much downward force is generated by
-	// the wings to keep the character afloat.
-	float AutoHover;
+	const float MaxFlySpeed = OwnerCharacter->GetCharacterMovement()->MaxFlySpeed;
+	Inputs.Speed = Velocity.Size();
+	Inputs.NormalizedSpeed = MaxFlySpeed > 0.0f ? Inputs.Speed / MaxFlySpeed : 0.0f;
+	Inputs.Density = Density;
+	Inputs.TemperatureCelsius = Temperature;
+	Inputs.WeightRatio = WeightRatio;
+	Inputs.GroundProximity = InGroundProximity;
+	Inputs.GroundEffect = GroundEffectStrength;
+	Inputs.DragCoefficient = State != EALSFlightState::None ? DragCoefficient : 0.0f;
+	Inputs.MaxLiftRatio = MaxLiftRatio;
+	return Inputs;
+}
 
-	// Represents the strength of the wings forcing downward when flying, measured in the units below the character that
-	// the pressure gradient extends.
-	const float WingPressureDepth = 200; //@todo old calculation: FlightStrengthPassive / EffectiveWeight;
+void UALSFlightComponent::CalculateMoveAero(const EALSFlightState State, const FVector& Location,
+                                            const FVector& Velocity, float& OutLiftRatio,
+                                            float& OutDragDeceleration, float& OutUpdraftAcceleration) const
+{
+	const FALSAtmosphereSample MoveAtmosphere = AtmosphereSubsystem
+		                                            ? AtmosphereSubsystem->Sample(Location)
+		                                            : FALSAtmosphereSample();
+
+	const FVector Bottom = Location - FVector{0, 0, OwnerCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()};
+	const float MoveGroundProximity = SampleGroundProximity(Bottom, Velocity);
+
+	const FALSAeroInputs Inputs = MakeAeroInputsAt(State, Velocity, MoveAtmosphere.Density, MoveGroundProximity);
+	OutLiftRatio = ALS::Aero::SolveLiftRatio(Inputs.BaseLift, Inputs.SpeedLift, Inputs.NormalizedSpeed,
+	                                         Inputs.Density, Inputs.TemperatureCelsius, Inputs.WeightRatio,
+	                                         Inputs.GroundProximity, Inputs.GroundEffect, Inputs.MaxLiftRatio);
+	OutDragDeceleration = ALS::Aero::SolveDragDeceleration(Inputs.Speed, Inputs.Density, Inputs.TemperatureCelsius,
+	                                                       Inputs.WeightRatio, Inputs.DragCoefficient);
+	OutUpdraftAcceleration = MoveAtmosphere.UpdraftAcceleration;
+}
 
+FVector UALSFlightComponent::GetDownwashDirection(const FVector& Velocity) const
+{
 	FVector VelocityDirection;
 	float VelocityLength;
-	OwnerCharacter->GetVelocity().ToDirectionAndLength(VelocityDirection, VelocityLength);
+	Velocity.ToDirectionAndLength(VelocityDirection, VelocityLength);
 
 	const float VelocityAlpha = FMath::GetMappedRangeValueClamped(FVector2f{0, OwnerCharacter->GetCharacterMovement()->MaxFlySpeed * 1.5f},
-																  FVector2f{0, 1},
-																  VelocityLength);
-
-	const FVector PressureDirection = FMath::Lerp(FVector(0, 0, -1), -VelocityDirection, VelocityAlpha);
-
-	const float PressureAlpha = FlightDistanceCheck(WingPressureDepth, PressureDirection) / WingPressureDepth;
-
-	// If a pressure curve is used, modify speed. Otherwise, default to 1 for no effect.
-	float GroundPressure;
-	//if (GroundPressureFalloff)
-	//{
-	//	GroundPressure = GroundPressureFalloff->GetFloatValue(PressureAlpha);
-	//}
-	//else
-	{
-		GroundPressure = 1;
-	}
-
-	const float LocalTemperatureAffect = 1; // TemperatureAffect.Y;
-	const float LocalWeightAffect = 1; //WeightAffect.Y;
-
-	// @TODO Design an algorithm for calculating thrust, and use it to determine lift. modify auto-thrust with that so that the player slowly drifts down when too heavy.
+	                                                              FVector2f{0, 1},
+	                                                              VelocityLength);
+	return FMath::Lerp(FVector(0, 0, -1), -VelocityDirection, VelocityAlpha).GetSafeNormal();
+}
 
-	switch (OwnerCharacter->GetFlightState())
-	{
-	case EALSFlightState::None: return;
-	case EALSFlightState::Hovering:
-		AutoHover = (GroundPressure + 0.5) / 1.5 * LocalTemperatureAffect * (LocalWeightAffect / 2);
-		break;
-	case EALSFlightState::Aerial:
-		AutoHover = (GroundPressure + 0.5) / 1.5 * LocalTemperatureAffect * LocalWeightAffect;
-		break;
-	//case EALSFlightState::Raising:
-	//	AutoHover = (GroundPressure + FlightStrengthActive) * LocalTemperatureAffect * (
-	//		LocalWeightAffect * 1.5);
-	//	break;
-	//case EALSFlightState::Lowering:
-	//	AutoHover = (GroundPressure * 0.5f) + (-FlightStrengthActive + (LocalTemperatureAffect
-	//		- 1)) + -LocalWeightAffect;
-	//	break;
-	default: return;
-	}
+void UALSFlightComponent::SetWeightRatio(const float NewWeightRatio)
+{
+	WeightRatio = FMath::Max(NewWeightRatio, 0.01f);
+}
 
-	const FRotator DirRotator(0.0f, OwnerCharacter->GetAimingRotation().Yaw, 0.0f);
-	//AddMovementInput(UKismetMathLibrary::GetUpVector(DirRotator), AutoHover, true);
+void UALSFlightComponent::SetTemperature(const float NewTemperature)
+{
+	Temperature = NewTemperature;
 }
 
-// @TODO flight catching should really be in the movement state machine not in the flight component.
 bool UALSFlightComponent::WantsToCatchFalling_Implementation() const
 {
-	if (TimeToWaitBeforeCatchFalling >= 0)
-	{
-		if (FDateTime::Now() - TimeStartingFalling >= FTimespan::FromSeconds(TimeToWaitBeforeCatchFalling))
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return true;
 }
 
 float UALSFlightComponent::FlightDistanceCheck(float CheckDistance, FVector Direction) const
+{
+	const FVector CheckStart = OwnerCharacter->GetActorLocation() - FVector{0, 0,
+		OwnerCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()};
+	return TraceFlightDistance(CheckStart, CheckDistance, Direction);
+}
+
+float UALSFlightComponent::TraceFlightDistance(const FVector& CheckStart, const float CheckDistance,
+                                               const FVector& Direction) const
 {
 	UWorld* World = GetWorld();
 	if (!World) return 0.f;
@@ -252,8 +319,6 @@ float UALSFlightComponent::FlightDistanceCheck(float CheckDistance, FVector Dire
 	FCollisionQueryParams Params;
 	Params.AddIgnoredActor(OwnerCharacter);
 
-	const FVector CheckStart = OwnerCharacter->GetActorLocation() - FVector{0, 0,
-		OwnerCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()};
 	const FVector CheckEnd = CheckStart + (Direction * CheckDistance);
 	bool bHit = World->LineTraceSingleByChannel(HitResult, CheckStart, CheckEnd, UALS_Settings::Get()->FlightCheckChannel, Params);
 
@@ -272,7 +337,7 @@ void UALSFlightComponent::AdjustFlightInput(FVector& WorldDirection, float& Scal
 	if (ScaleValue == 0.f) return;
 
 	/**
-	const float AltitudeAdjustedAngle = MaxFlightForwardAngle * AtmosphereAtAltitude;
+	const float AltitudeAdjustedAngle = MaxFlightForwardAngle * Atmosphere.Density;
 
 	float Pitch = OwnerCharacter->GetAimingRotation().Pitch;
 	if (ScaleValue >= 0.f) // Going forward
@@ -291,7 +356,7 @@ void UALSFlightComponent::AdjustFlightInput(FVector& WorldDirection, float& Scal
 
 	// Prevent the player from flying above world max height.
 	const FVector PlanarDirection = FVector(WorldDirection.X, WorldDirection.Y, 0).GetSafeNormal();
-	const FVector NewDirection = FMath::Lerp(PlanarDirection, WorldDirection, AtmosphereAtAltitude);
+	const FVector NewDirection = FMath::Lerp(PlanarDirection, WorldDirection, Atmosphere.Density);
 
 	if (ALSDebugFlightTraces)
 	{
@@ -309,6 +374,12 @@ void UALSFlightComponent::AdjustFlightInput(FVector& WorldDirection, float& Scal
 
 bool UALSFlightComponent::CanFly() const
 {
+	// Sampled here rather than taken from the last flight tick, since flight may not have started yet.
+	if (AtmosphereSubsystem && AtmosphereSubsystem->Sample(OwnerCharacter->GetActorLocation()).bNoFly)
+	{
+		return false;
+	}
+
 	return OwnerCharacter->GetMyMovementComponent()->CanEverFly() && FlightCheck();
 }
 
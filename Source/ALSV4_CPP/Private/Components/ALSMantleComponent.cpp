@@ -9,10 +9,13 @@
 #include "Character/ALSCharacter.h"
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Components/ALSDebugComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "Curves/CurveVector.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Library/ALSMantleQueryLibrary.h"
 #include "Library/ALSMathLibrary.h"
+#include "Subsystems/ALSLedgeSubsystem.h"
 
 using namespace ALS::MantleComponent;
 
@@ -22,8 +25,6 @@ UALSMantleComponent::UALSMantleComponent()
 	PrimaryComponentTick.bStartWithTickEnabled = true;
 
 	MantleObjectDetectionProfile = NAME_IgnoreOnlyPawn;
-
-	MantleTimeline = CreateDefaultSubobject<UTimelineComponent>(NAME_MantleTimeline);
 }
 
 void UALSMantleComponent::BeginPlay()
@@ -36,18 +37,14 @@ void UALSMantleComponent::BeginPlay()
 		if (IsValid(OwnerCharacter))
 		{
 			ALSDebugComponent = OwnerCharacter->FindComponentByClass<UALSDebugComponent>();
+			LedgeSubsystem = GetWorld()->GetSubsystem<UALSLedgeSubsystem>();
 
 			AddTickPrerequisiteActor(OwnerCharacter); // Always tick after owner, so we'll use updated values
 
 			// Bindings
-			FOnTimelineFloat TimelineUpdated;
-			FOnTimelineEvent TimelineFinished;
-			TimelineUpdated.BindUFunction(this, NAME_MantleUpdate);
-			TimelineFinished.BindUFunction(this, NAME_MantleEnd);
-			MantleTimeline->SetTimelineFinishedFunc(TimelineFinished);
-			MantleTimeline->SetLooping(false);
-			MantleTimeline->SetTimelineLengthMode(TL_TimelineLength);
-			MantleTimeline->AddInterpFloat(MantleTimelineCurve, TimelineUpdated);
+			ForwardTraceDelegate.BindUObject(this, &UALSMantleComponent::OnAsyncForwardTrace);
+			DownwardTraceDelegate.BindUObject(this, &UALSMantleComponent::OnAsyncDownwardTrace);
+			RoomTraceDelegate.BindUObject(this, &UALSMantleComponent::OnAsyncRoomTrace);
 
 			OwnerCharacter->JumpPressedDelegate.AddUniqueDynamic(this, &UALSMantleComponent::OnOwnerJumpInput);
 			OwnerCharacter->RagdollStateChangedDelegate.AddUniqueDynamic(
@@ -69,6 +66,12 @@ void UALSMantleComponent::TickComponent(const float DeltaTime, const ELevelTick
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (bMantlePlaying)
+	{
+		TickMantle(DeltaTime);
+		return;
+	}
+
 	if (OwnerCharacter)
 	{
 		if (OwnerCharacter->GetMovementState() == EALSMovementState::Freefall)
@@ -76,7 +79,7 @@ void UALSMantleComponent::TickComponent(const float DeltaTime, const ELevelTick
 			// Perform a mantle check if falling while movement input is pressed or if always checking.
 			if (OwnerCharacter->HasMovementInput() || bAlwaysCatchIfFalling)
 			{
-				MantleCheck(FallingTraceSettings, EDrawDebugTrace::Type::ForOneFrame);
+				AutomaticMantleCheck(FallingTraceSettings);
 			}
 		}
 		else if (OwnerCharacter->GetMovementState() == EALSMovementState::Grounded)
@@ -84,16 +87,118 @@ void UALSMantleComponent::TickComponent(const float DeltaTime, const ELevelTick
 			// Perform a mantle check to detect short obstacles to auto-mantle.
 			if (OwnerCharacter->HasMovementInput() && AutomaticallyVaultSmallObstacles)
 			{
-				MantleCheck(AutomaticTraceSettings, EDrawDebugTrace::Type::ForOneFrame);
+				AutomaticMantleCheck(AutomaticTraceSettings);
 			}
 		}
 	}
 }
 
+void UALSMantleComponent::AutomaticMantleCheck(const FALSMantleTraceSettings& TraceSettings)
+{
+	if (bAsyncCheckPending)
+	{
+		return;
+	}
+
+	const FVector Location = OwnerCharacter->GetActorLocation();
+	const FVector Direction = OwnerCharacter->GetActorForwardVector();
+
+	// Skip checks from about where the last one found nothing. How far the character has to move makes checks scale
+	// with speed, the interval catches changes in front of a character that stands still.
+	const float SkipDistance = TraceSettings.ReachDistance * AutomaticCheckReachFraction;
+	if (LastFailedCheckSettings == &TraceSettings &&
+		GetWorld()->GetTimeSeconds() - LastFailedCheckTime < AutomaticCheckMaxInterval &&
+		FVector::DistSquared(Location, LastFailedCheckLocation) < FMath::Square(SkipDistance) &&
+		(Direction | LastFailedCheckDirection) > FMath::Cos(FMath::DegreesToRadians(AutomaticCheckAngleThreshold)))
+	{
+		return;
+	}
+
+	if (!MayHaveLedgeInReach(TraceSettings))
+	{
+		RecordFailedCheck(TraceSettings, Location, Direction);
+		return;
+	}
+
+	if (bAsyncAutomaticChecks)
+	{
+		if (MantleCheckAsync(TraceSettings))
+		{
+			AsyncCheck.AutomaticSettings = &TraceSettings;
+		}
+		return;
+	}
+
+	if (MantleCheck(TraceSettings, EDrawDebugTrace::Type::ForOneFrame))
+	{
+		LastFailedCheckSettings = nullptr;
+		return;
+	}
+
+	RecordFailedCheck(TraceSettings, Location, Direction);
+}
+
+void UALSMantleComponent::RecordFailedCheck(const FALSMantleTraceSettings& TraceSettings, const FVector& Location,
+                                            const FVector& Direction)
+{
+	LastFailedCheckSettings = &TraceSettings;
+	LastFailedCheckLocation = Location;
+	LastFailedCheckDirection = Direction;
+	LastFailedCheckTime = GetWorld()->GetTimeSeconds();
+}
+
+bool UALSMantleComponent::MayHaveLedgeInReach(const FALSMantleTraceSettings& TraceSettings) const
+{
+	// Missing a ledge to catch a fall costs more than the sweeps, so falling checks always run.
+	if (!bUseLedgeDatabase || !LedgeSubsystem || &TraceSettings == &FallingTraceSettings)
+	{
+		return true;
+	}
+
+	const FVector CapsuleBaseLocation = UALSMathLibrary::GetCapsuleBaseLocation(
+		2.0f, OwnerCharacter->GetCapsuleComponent());
+	if (!LedgeSubsystem->IsCovered(CapsuleBaseLocation))
+	{
+		return true;
+	}
+
+	// Same region as the forward trace of MantleCheck.
+	const FVector& TraceDirection = OwnerCharacter->GetActorForwardVector();
+	const FVector TraceStart = CapsuleBaseLocation + TraceDirection * -30.0f;
+	const float MinZ = CapsuleBaseLocation.Z + TraceSettings.MinLedgeHeight;
+	const float MaxZ = CapsuleBaseLocation.Z + TraceSettings.MaxLedgeHeight;
+	if (LedgeSubsystem->FindLedgeInReach(TraceStart, TraceDirection, TraceSettings.ReachDistance,
+	                                     TraceSettings.ForwardTraceRadius, MinZ, MaxZ))
+	{
+		return true;
+	}
+
+	// Only static geometry is baked, so anything movable in the same region still needs the sweeps.
+	const FVector Direction2D = TraceDirection.GetSafeNormal2D();
+	const FVector BoxCenter(FVector2D(TraceStart + Direction2D * (TraceSettings.ReachDistance * 0.5f)),
+	                        (MinZ + MaxZ) * 0.5f);
+	const FVector BoxExtent(TraceSettings.ReachDistance * 0.5f + TraceSettings.ForwardTraceRadius,
+	                        TraceSettings.ForwardTraceRadius, (MaxZ - MinZ) * 0.5f);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSMantleMovableCheck), false, OwnerCharacter);
+	TArray<FOverlapResult> Overlaps;
+	GetWorld()->OverlapMultiByProfile(Overlaps, BoxCenter, FRotationMatrix::MakeFromX(Direction2D).ToQuat(),
+	                                  MantleObjectDetectionProfile, FCollisionShape::MakeBox(BoxExtent), Params);
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		const UPrimitiveComponent* Component = Overlap.GetComponent();
+		if (Component && Component->Mobility != EComponentMobility::Static)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void UALSMantleComponent::MantleStart(const float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
                                       const EALSMantleType MantleType)
 {
-	if (OwnerCharacter == nullptr || !IsValid(MantleLedgeWS.Component) || !IsValid(MantleTimeline))
+	if (OwnerCharacter == nullptr || !IsValid(MantleLedgeWS.Component))
 	{
 		return;
 	}
@@ -108,8 +213,10 @@ void UALSMantleComponent::MantleStart(const float MantleHeight, const FALSCompon
 		Cast<AALSCharacter>(OwnerCharacter)->ClearHeldObject();
 	}
 
-	// Disable ticking during mantle
-	SetComponentTickEnabledAsync(false);
+	// A mantle started otherwise supersedes a running async check.
+	CancelAsyncMantleCheck();
+
+	OwnerCharacter->BumpNetUpdateFrequency();
 
 	// Step 1: Get the Mantle Asset and use it to set the new Mantle Params.
 	const FALSMantleAsset MantleAsset = GetMantleAsset(MantleType, OwnerCharacter->GetOverlayState());
@@ -129,12 +236,9 @@ void UALSMantleComponent::MantleStart(const float MantleHeight, const FALSCompon
 	                                                          MantleHeight);
 
 	// Step 2: Convert the world space target to the mantle component's local space for use in moving objects.
-	MantleLedgeLS.Component = MantleLedgeWS.Component;
-	MantleLedgeLS.Transform = MantleLedgeWS.Transform * MantleLedgeWS.Component->GetComponentToWorld().Inverse();
+	SetMantleLedge(MantleLedgeWS);
 
-	// Step 3: Set the Mantle Target and calculate the Starting Offset
-	// (offset amount between the actor and target transform).
-	MantleTarget = MantleLedgeWS.Transform;
+	// Step 3: Calculate the Starting Offset (offset amount between the actor and target transform).
 	MantleActualStartOffset = UALSMathLibrary::TransformSub(OwnerCharacter->GetActorTransform(), MantleTarget);
 
 	// Step 4: Calculate the Animated Start Offset from the Target Location.
@@ -155,9 +259,9 @@ void UALSMantleComponent::MantleStart(const float MantleHeight, const FALSCompon
 	float MinTime = 0.0f;
 	float MaxTime = 0.0f;
 	MantleParams.PositionCorrectionCurve->GetTimeRange(MinTime, MaxTime);
-	MantleTimeline->SetTimelineLength(MaxTime - MantleParams.StartingPosition);
-	MantleTimeline->SetPlayRate(MantleParams.PlayRate);
-	MantleTimeline->PlayFromStart();
+	MantlePlaybackLength = MaxTime - MantleParams.StartingPosition;
+	MantlePlaybackPosition = 0.0f;
+	bMantlePlaying = true;
 
 	// Step 7: Play the Anim Montage if valid.
 	if (MantleParams.AnimMontage && OwnerCharacter->GetMesh()->GetAnimInstance())
@@ -175,33 +279,33 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 		return false;
 	}
 
-	// Step 1: Trace forward to find a wall / object the character cannot walk on.
-	const FVector& TraceDirection = OwnerCharacter->GetActorForwardVector();
-	const FVector& CapsuleBaseLocation = UALSMathLibrary::GetCapsuleBaseLocation(
-		2.0f, OwnerCharacter->GetCapsuleComponent());
-	FVector TraceStart = CapsuleBaseLocation + TraceDirection * -30.0f;
-	TraceStart.Z += (TraceSettings.MaxLedgeHeight + TraceSettings.MinLedgeHeight) / 2.0f;
-	const FVector TraceEnd = TraceStart + TraceDirection * TraceSettings.ReachDistance;
-	const float HalfHeight = 1.0f + (TraceSettings.MaxLedgeHeight - TraceSettings.MinLedgeHeight) / 2.0f;
-
 	UWorld* World = GetWorld();
 	check(World);
 
+	const bool bDrawDebug = ALSDebugComponent && ALSDebugComponent->GetShowTraces();
+
 	FCollisionQueryParams Params;
 	Params.AddIgnoredActor(OwnerCharacter);
 
+	FMantleCheckContext Context = MakeMantleCheckContext(TraceSettings);
+	FVector TraceStart;
+	FVector TraceEnd;
+	FCollisionShape CollisionShape;
+
+	// Step 1: Trace forward to find a wall / object the character cannot walk on.
 	FHitResult HitResult;
 	{
-		const FCollisionShape CapsuleCollisionShape = FCollisionShape::MakeCapsule(TraceSettings.ForwardTraceRadius, HalfHeight);
+		UALSMantleQueryLibrary::GetForwardTrace(Context.TraceSettings, Context.CapsuleBaseLocation,
+		                                        Context.TraceDirection, TraceStart, TraceEnd, CollisionShape);
 		const bool bHit = World->SweepSingleByProfile(HitResult, TraceStart, TraceEnd, FQuat::Identity, MantleObjectDetectionProfile,
-	                                                  CapsuleCollisionShape, Params);
+		                                              CollisionShape, Params);
 
-		if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
+		if (bDrawDebug)
 		{
 			UALSDebugComponent::DrawDebugCapsuleTraceSingle(World,
 			                                                TraceStart,
 			                                                TraceEnd,
-			                                                CapsuleCollisionShape,
+			                                                CollisionShape,
 			                                                DebugType,
 			                                                bHit,
 			                                                HitResult,
@@ -211,44 +315,26 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 		}
 	}
 
-	if (!HitResult.IsValidBlockingHit() || OwnerCharacter->GetCharacterMovement()->IsWalkable(HitResult))
+	if (!CheckForwardHit(Context, HitResult))
 	{
-		// Not a valid surface to mantle
 		return false;
 	}
 
-	if (HitResult.GetComponent() != nullptr)
-	{
-		UPrimitiveComponent* PrimitiveComponent = HitResult.GetComponent();
-		if (PrimitiveComponent && PrimitiveComponent->GetComponentVelocity().Size() > AcceptableVelocityWhileMantling)
-		{
-			// The surface to mantle moves too fast
-			return false;
-		}
-	}
-
-	const FVector InitialTraceImpactPoint = HitResult.ImpactPoint;
-	const FVector InitialTraceNormal = HitResult.ImpactNormal;
-
 	// Step 2: Trace downward from the first trace's Impact Point and determine if the hit location is walkable.
-	FVector DownwardTraceEnd = InitialTraceImpactPoint;
-	DownwardTraceEnd.Z = CapsuleBaseLocation.Z;
-	DownwardTraceEnd += InitialTraceNormal * -15.0f;
-	FVector DownwardTraceStart = DownwardTraceEnd;
-	DownwardTraceStart.Z += TraceSettings.MaxLedgeHeight + TraceSettings.DownwardTraceRadius + 1.0f;
-
 	{
-		const FCollisionShape SphereCollisionShape = FCollisionShape::MakeSphere(TraceSettings.DownwardTraceRadius);
-		const bool bHit = World->SweepSingleByChannel(HitResult, DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
-	                                                  WalkableSurfaceDetectionChannel, SphereCollisionShape,
-	                                                  Params);
-
-		if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
+		UALSMantleQueryLibrary::GetDownwardTrace(Context.TraceSettings, Context.CapsuleBaseLocation,
+		                                         Context.InitialTraceImpactPoint, Context.InitialTraceNormal,
+		                                         TraceStart, TraceEnd, CollisionShape);
+		const bool bHit = World->SweepSingleByChannel(HitResult, TraceStart, TraceEnd, FQuat::Identity,
+		                                              WalkableSurfaceDetectionChannel, CollisionShape,
+		                                              Params);
+
+		if (bDrawDebug)
 		{
 			UALSDebugComponent::DrawDebugSphereTraceSingle(World,
 			                                               TraceStart,
 			                                               TraceEnd,
-			                                               SphereCollisionShape,
+			                                               CollisionShape,
 			                                               DebugType,
 			                                               bHit,
 			                                               HitResult,
@@ -258,23 +344,15 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 		}
 	}
 
-
-	if (!OwnerCharacter->GetCharacterMovement()->IsWalkable(HitResult))
+	if (!CheckDownwardHit(Context, HitResult))
 	{
-		// Not a valid surface to mantle
 		return false;
 	}
 
-	const FVector DownTraceLocation(HitResult.Location.X, HitResult.Location.Y, HitResult.ImpactPoint.Z);
-	UPrimitiveComponent* HitComponent = HitResult.GetComponent();
-
 	// Step 3: Check if the capsule has room to stand at the downward trace's location.
-	// If so, set that location as the Target Transform and calculate the mantle height.
-	const FVector& CapsuleLocationFBase = UALSMathLibrary::GetCapsuleLocationFromBase(
-		DownTraceLocation, 2.0f, OwnerCharacter->GetCapsuleComponent());
 	const bool bCapsuleHasRoom = UALSMathLibrary::CapsuleHasRoomCheck(OwnerCharacter->GetCapsuleComponent(),
-	                                                                  CapsuleLocationFBase, 0.0f,
-	                                                                  0.0f, DebugType, ALSDebugComponent && ALSDebugComponent->GetShowTraces());
+	                                                                  Context.CapsuleLocationFBase, 0.0f,
+	                                                                  0.0f, DebugType, bDrawDebug);
 
 	if (!bCapsuleHasRoom)
 	{
@@ -282,14 +360,294 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 		return false;
 	}
 
+	// Step 4: If everything checks out, start the Mantle
+	StartCheckedMantle(Context);
+	return true;
+}
+
+bool UALSMantleComponent::MantleCheckAsync(const FALSMantleTraceSettings& TraceSettings)
+{
+	if (!OwnerCharacter || bAsyncCheckPending)
+	{
+		return false;
+	}
+
+	AsyncCheck = MakeMantleCheckContext(TraceSettings);
+	AsyncCheckSerial++;
+	bAsyncCheckPending = true;
+
+	FVector TraceStart;
+	FVector TraceEnd;
+	FCollisionShape CollisionShape;
+	UALSMantleQueryLibrary::GetForwardTrace(AsyncCheck.TraceSettings, AsyncCheck.CapsuleBaseLocation,
+	                                        AsyncCheck.TraceDirection, TraceStart, TraceEnd, CollisionShape);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSMantleCheck));
+	Params.AddIgnoredActor(OwnerCharacter);
+
+	GetWorld()->AsyncSweepByProfile(EAsyncTraceType::Single, TraceStart, TraceEnd, FQuat::Identity,
+	                                MantleObjectDetectionProfile, CollisionShape, Params, &ForwardTraceDelegate,
+	                                AsyncCheckSerial);
+	return true;
+}
+
+void UALSMantleComponent::CancelAsyncMantleCheck()
+{
+	// Results of traces still in flight no longer match the serial and are dropped.
+	AsyncCheckSerial++;
+	bAsyncCheckPending = false;
+}
+
+bool UALSMantleComponent::IsAsyncCheckCurrent(const FTraceDatum& Datum) const
+{
+	return bAsyncCheckPending && Datum.UserData == AsyncCheckSerial && OwnerCharacter;
+}
+
+bool UALSMantleComponent::IsAsyncCheckStillValid() const
+{
+	// The character may have landed, ragdolled or started another action while the traces were in flight.
+	if (OwnerCharacter->GetMovementState() != AsyncCheck.MovementState ||
+		OwnerCharacter->GetMovementAction() != EALSMovementAction::None)
+	{
+		return false;
+	}
+
+	// Falling characters cover a lot of ground in the few frames of latency, but the mantle blends from wherever the
+	// character is when it starts, so the ledge found still applies.
+	if (AsyncCheck.MovementState == EALSMovementState::Freefall)
+	{
+		return true;
+	}
+
+	// Otherwise only drop results if the character moved further than its speed explains, e.g. when teleported.
+	const float Latency = GetWorld()->GetTimeSeconds() - AsyncCheck.StartTime;
+	const float MaxDistance = AsyncCheck.TraceSettings.ForwardTraceRadius + AsyncCheck.Speed * Latency;
+	return FVector::DistSquared(OwnerCharacter->GetActorLocation(), AsyncCheck.ActorLocation) <=
+		FMath::Square(MaxDistance);
+}
+
+void UALSMantleComponent::OnAsyncForwardTrace(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	if (!IsAsyncCheckCurrent(Datum))
+	{
+		return;
+	}
+
+	const FHitResult HitResult = Datum.OutHits.IsEmpty() ? FHitResult() : Datum.OutHits[0];
+
+	// Automatic checks, so drawn like the synchronous ones from AutomaticMantleCheck.
+	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
+	{
+		UALSDebugComponent::DrawDebugCapsuleTraceSingle(GetWorld(),
+		                                                Datum.Start,
+		                                                Datum.End,
+		                                                Datum.CollisionParams.CollisionShape,
+		                                                EDrawDebugTrace::Type::ForOneFrame,
+		                                                HitResult.bBlockingHit,
+		                                                HitResult,
+		                                                FLinearColor::Black,
+		                                                FLinearColor::Black,
+		                                                1.0f);
+	}
+
+	if (!IsAsyncCheckStillValid())
+	{
+		CancelAsyncMantleCheck();
+		return;
+	}
+
+	if (!CheckForwardHit(AsyncCheck, HitResult))
+	{
+		FinishAsyncMantleCheck(false);
+		return;
+	}
+
+	FVector TraceStart;
+	FVector TraceEnd;
+	FCollisionShape CollisionShape;
+	UALSMantleQueryLibrary::GetDownwardTrace(AsyncCheck.TraceSettings, AsyncCheck.CapsuleBaseLocation,
+	                                         AsyncCheck.InitialTraceImpactPoint, AsyncCheck.InitialTraceNormal,
+	                                         TraceStart, TraceEnd, CollisionShape);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSMantleCheck));
+	Params.AddIgnoredActor(OwnerCharacter);
+
+	GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, FQuat::Identity,
+	                                WalkableSurfaceDetectionChannel, CollisionShape, Params,
+	                                FCollisionResponseParams::DefaultResponseParam, &DownwardTraceDelegate,
+	                                AsyncCheckSerial);
+}
+
+void UALSMantleComponent::OnAsyncDownwardTrace(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	if (!IsAsyncCheckCurrent(Datum))
+	{
+		return;
+	}
+
+	const FHitResult HitResult = Datum.OutHits.IsEmpty() ? FHitResult() : Datum.OutHits[0];
+
+	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
+	{
+		UALSDebugComponent::DrawDebugSphereTraceSingle(GetWorld(),
+		                                               Datum.Start,
+		                                               Datum.End,
+		                                               Datum.CollisionParams.CollisionShape,
+		                                               EDrawDebugTrace::Type::ForOneFrame,
+		                                               HitResult.bBlockingHit,
+		                                               HitResult,
+		                                               FLinearColor::Black,
+		                                               FLinearColor::Black,
+		                                               1.0f);
+	}
+
+	if (!IsAsyncCheckStillValid())
+	{
+		CancelAsyncMantleCheck();
+		return;
+	}
+
+	if (!CheckDownwardHit(AsyncCheck, HitResult))
+	{
+		FinishAsyncMantleCheck(false);
+		return;
+	}
+
+	FVector TraceStart;
+	FVector TraceEnd;
+	float Radius;
+	const UCapsuleComponent* Capsule = OwnerCharacter->GetCapsuleComponent();
+	UALSMathLibrary::GetCapsuleHasRoomTrace(AsyncCheck.CapsuleLocationFBase, Capsule->GetScaledCapsuleRadius(),
+	                                        Capsule->GetScaledCapsuleHalfHeight(), 0.0f, 0.0f, TraceStart, TraceEnd,
+	                                        Radius);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSMantleCheck));
+	Params.AddIgnoredActor(OwnerCharacter);
+
+	GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, FQuat::Identity, ECC_Visibility,
+	                                FCollisionShape::MakeSphere(Radius), Params,
+	                                FCollisionResponseParams::DefaultResponseParam, &RoomTraceDelegate,
+	                                AsyncCheckSerial);
+}
+
+void UALSMantleComponent::OnAsyncRoomTrace(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	if (!IsAsyncCheckCurrent(Datum))
+	{
+		return;
+	}
+
+	const bool bCapsuleHasRoom = !Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit)
+	{
+		return Hit.bBlockingHit || Hit.bStartPenetrating;
+	});
+
+	// Same colors as UALSMathLibrary::CapsuleHasRoomCheck.
+	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
+	{
+		UALSDebugComponent::DrawDebugSphereTraceSingle(GetWorld(),
+		                                               Datum.Start,
+		                                               Datum.End,
+		                                               Datum.CollisionParams.CollisionShape,
+		                                               EDrawDebugTrace::Type::ForOneFrame,
+		                                               !bCapsuleHasRoom,
+		                                               Datum.OutHits.IsEmpty() ? FHitResult() : Datum.OutHits[0],
+		                                               FLinearColor(0.130706f, 0.896269f, 0.144582f, 1.0f),  // light green
+		                                               FLinearColor(0.932733f, 0.29136f, 1.0f, 1.0f),        // light purple
+		                                               1.0f);
+	}
+
+	if (!IsAsyncCheckStillValid())
+	{
+		CancelAsyncMantleCheck();
+		return;
+	}
+
+	if (bCapsuleHasRoom)
+	{
+		StartCheckedMantle(AsyncCheck);
+	}
+
+	FinishAsyncMantleCheck(bCapsuleHasRoom);
+}
+
+void UALSMantleComponent::FinishAsyncMantleCheck(const bool bSuccess)
+{
+	bAsyncCheckPending = false;
+
+	if (bSuccess)
+	{
+		LastFailedCheckSettings = nullptr;
+	}
+	else if (AsyncCheck.AutomaticSettings)
+	{
+		RecordFailedCheck(*AsyncCheck.AutomaticSettings, AsyncCheck.ActorLocation, AsyncCheck.TraceDirection);
+	}
+}
+
+UALSMantleComponent::FMantleCheckContext UALSMantleComponent::MakeMantleCheckContext(
+	const FALSMantleTraceSettings& TraceSettings) const
+{
+	FMantleCheckContext Context;
+	Context.TraceSettings = TraceSettings;
+	Context.MovementState = OwnerCharacter->GetMovementState();
+	Context.ActorLocation = OwnerCharacter->GetActorLocation();
+	Context.Speed = OwnerCharacter->GetVelocity().Size();
+	Context.StartTime = GetWorld()->GetTimeSeconds();
+	Context.TraceDirection = OwnerCharacter->GetActorForwardVector();
+	Context.CapsuleBaseLocation = UALSMathLibrary::GetCapsuleBaseLocation(2.0f, OwnerCharacter->GetCapsuleComponent());
+	return Context;
+}
+
+bool UALSMantleComponent::CheckForwardHit(FMantleCheckContext& Context, const FHitResult& HitResult) const
+{
+	if (!HitResult.IsValidBlockingHit() || OwnerCharacter->GetCharacterMovement()->IsWalkable(HitResult))
+	{
+		// Not a valid surface to mantle
+		return false;
+	}
+
+	if (HitResult.GetComponent() != nullptr)
+	{
+		UPrimitiveComponent* PrimitiveComponent = HitResult.GetComponent();
+		if (PrimitiveComponent && PrimitiveComponent->GetComponentVelocity().Size() > AcceptableVelocityWhileMantling)
+		{
+			// The surface to mantle moves too fast
+			return false;
+		}
+	}
+
+	Context.InitialTraceImpactPoint = HitResult.ImpactPoint;
+	Context.InitialTraceNormal = HitResult.ImpactNormal;
+	return true;
+}
+
+bool UALSMantleComponent::CheckDownwardHit(FMantleCheckContext& Context, const FHitResult& HitResult) const
+{
+	if (!OwnerCharacter->GetCharacterMovement()->IsWalkable(HitResult))
+	{
+		// Not a valid surface to mantle
+		return false;
+	}
+
+	const FVector DownTraceLocation(HitResult.Location.X, HitResult.Location.Y, HitResult.ImpactPoint.Z);
+	Context.HitComponent = HitResult.GetComponent();
+	Context.CapsuleLocationFBase = UALSMathLibrary::GetCapsuleLocationFromBase(
+		DownTraceLocation, 2.0f, OwnerCharacter->GetCapsuleComponent());
+	return true;
+}
+
+void UALSMantleComponent::StartCheckedMantle(const FMantleCheckContext& Context)
+{
+	// Set the location the capsule has room at as the Target Transform and calculate the mantle height.
 	const FTransform TargetTransform(
-		(InitialTraceNormal * FVector(-1.0f, -1.0f, 0.0f)).ToOrientationRotator(),
-		CapsuleLocationFBase,
+		(Context.InitialTraceNormal * FVector(-1.0f, -1.0f, 0.0f)).ToOrientationRotator(),
+		Context.CapsuleLocationFBase,
 		FVector::OneVector);
 
-	const float MantleHeight = (CapsuleLocationFBase - OwnerCharacter->GetActorLocation()).Z;
+	const float MantleHeight = (Context.CapsuleLocationFBase - OwnerCharacter->GetActorLocation()).Z;
 
-	// Step 4: Determine the Mantle Type by checking the movement mode and Mantle Height.
+	// Determine the Mantle Type by checking the movement mode and Mantle Height.
 	EALSMantleType MantleType;
 	if (OwnerCharacter->GetMovementState() == EALSMovementState::Freefall)
 	{
@@ -300,14 +658,11 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 		MantleType = MantleHeight > 125.0f ? EALSMantleType::HighMantle : EALSMantleType::LowMantle;
 	}
 
-	// Step 5: If everything checks out, start the Mantle
 	FALSComponentAndTransform MantleWS;
-	MantleWS.Component = HitComponent;
+	MantleWS.Component = Context.HitComponent.Get();
 	MantleWS.Transform = TargetTransform;
 	MantleStart(MantleHeight, MantleWS, MantleType);
 	Server_MantleStart(MantleHeight, MantleWS, MantleType);
-
-	return true;
 }
 
 void UALSMantleComponent::Server_MantleStart_Implementation(const float MantleHeight,
@@ -327,7 +682,50 @@ void UALSMantleComponent::Multicast_MantleStart_Implementation(const float Mantl
 	}
 }
 
-// This function is called by "MantleTimeline" using BindUFunction in UALSMantleComponent::BeginPlay during the default settings initialization.
+void UALSMantleComponent::TickMantle(const float DeltaTime)
+{
+	// Plays like a non looping timeline of MantlePlaybackLength: updates at the new position, then ends once the
+	// position reached the end.
+	MantlePlaybackPosition = FMath::Min(MantlePlaybackPosition + DeltaTime * MantleParams.PlayRate,
+	                                    MantlePlaybackLength);
+
+	MantleUpdate(MantleTimelineCurve ? MantleTimelineCurve->GetFloatValue(MantlePlaybackPosition) : 1.0f);
+
+	if (bMantlePlaying && MantlePlaybackPosition >= MantlePlaybackLength)
+	{
+		MantleEnd();
+	}
+}
+
+void UALSMantleComponent::SetMantleLedge(const FALSComponentAndTransform& MantleLedgeWS)
+{
+	MantleLedgeLS.Component = MantleLedgeWS.Component;
+	MantleLedgeLS.Transform = MantleLedgeWS.Transform * MantleLedgeWS.Component->GetComponentToWorld().Inverse();
+	MantleLedgeComponentTransform = MantleLedgeWS.Component->GetComponentToWorld();
+	bMantleLedgeStatic = MantleLedgeWS.Component->Mobility == EComponentMobility::Static;
+	MantleTarget = MantleLedgeWS.Transform;
+}
+
+bool UALSMantleComponent::UpdateMantleTarget()
+{
+	// Static components can't move, and others only need it on frames they moved.
+	if (bMantleLedgeStatic || !IsValid(MantleLedgeLS.Component))
+	{
+		return false;
+	}
+
+	const FTransform& ComponentTransform = MantleLedgeLS.Component->GetComponentToWorld();
+	if (ComponentTransform.Equals(MantleLedgeComponentTransform, 0.0f))
+	{
+		return false;
+	}
+
+	MantleLedgeComponentTransform = ComponentTransform;
+	MantleTarget = UALSMathLibrary::MantleComponentLocalToWorld(MantleLedgeLS);
+	return true;
+}
+
+// This function is called every tick by TickMantle during a mantle, with the value of the MantleTimelineCurve.
 void UALSMantleComponent::MantleUpdate(const float BlendIn)
 {
 	if (!OwnerCharacter)
@@ -335,13 +733,13 @@ void UALSMantleComponent::MantleUpdate(const float BlendIn)
 		return;
 	}
 
-	// Step 1: Continually update the mantle target from the stored local transform to follow along with moving objects
-	MantleTarget = UALSMathLibrary::MantleComponentLocalToWorld(MantleLedgeLS);
+	// Step 1: Continually update the mantle target from the stored local transform to follow along with moving objects.
+	UpdateMantleTarget();
 
 	// Step 2: Update the Position and Correction Alphas using the Position/Correction curve set for each Mantle.
 	const FVector CurveVec = MantleParams.PositionCorrectionCurve
 	                                     ->GetVectorValue(
-		                                     MantleParams.StartingPosition + MantleTimeline->GetPlaybackPosition());
+		                                     MantleParams.StartingPosition + MantlePlaybackPosition);
 	const float PositionAlpha = CurveVec.X;
 	const float XYCorrectionAlpha = CurveVec.Y;
 	const float ZCorrectionAlpha = CurveVec.Z;
@@ -396,6 +794,8 @@ void UALSMantleComponent::MantleUpdate(const float BlendIn)
 
 void UALSMantleComponent::MantleEnd()
 {
+	bMantlePlaying = false;
+
 	// Set the Character Movement Mode to Walking
 	if (OwnerCharacter)
 	{
@@ -406,9 +806,6 @@ void UALSMantleComponent::MantleEnd()
 			Cast<AALSCharacter>(OwnerCharacter)->UpdateHeldObject();
 		}
 	}
-
-	// Enable ticking back after mantle ends
-	SetComponentTickEnabledAsync(true);
 }
 
 void UALSMantleComponent::OnOwnerJumpInput()
@@ -436,6 +833,7 @@ void UALSMantleComponent::OnOwnerRagdollStateChanged(const bool bRagdollState)
 	// If owner is going into ragdoll state, stop mantling immediately
 	if (bRagdollState)
 	{
-		MantleTimeline->Stop();
+		CancelAsyncMantleCheck();
+		bMantlePlaying = false;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Data/ALSCameraRigPreset.h"
+
+#include "ALSStaticNames.h"
+#include "Curves/CurveFloat.h"
+
+using namespace ALS::CameraManager;
+
+namespace ALS::CameraRig
+{
+	template <typename TEnum>
+	static bool MaskMatches(const int32 Mask, const TEnum Value)
+	{
+		return Mask == 0 || (Mask & (1 << static_cast<uint8>(Value))) != 0;
+	}
+}
+
+using namespace ALS::CameraRig;
+
+float FALSCameraRigParams::GetParam(const FName CurveName) const
+{
+	if (CurveName == NAME_RotationLagSpeed) return RotationLagSpeed;
+	if (CurveName == NAME_PivotLagSpeed_X) return PivotLagSpeed.X;
+	if (CurveName == NAME_PivotLagSpeed_Y) return PivotLagSpeed.Y;
+	if (CurveName == NAME_PivotLagSpeed_Z) return PivotLagSpeed.Z;
+	if (CurveName == NAME_PivotOffset_X) return PivotOffset.X;
+	if (CurveName == NAME_PivotOffset_Y) return PivotOffset.Y;
+	if (CurveName == NAME_PivotOffset_Z) return PivotOffset.Z;
+	if (CurveName == NAME_CameraOffset_X) return CameraOffset.X;
+	if (CurveName == NAME_CameraOffset_Y) return CameraOffset.Y;
+	if (CurveName == NAME_CameraOffset_Z) return CameraOffset.Z;
+	if (CurveName == NAME_Weight_FirstPerson) return Weight_FirstPerson;
+	if (CurveName == NAME_Override_Debug) return Override_Debug;
+	return 0.0f;
+}
+
+FALSCameraRigParams FALSCameraRigParams::Lerp(const FALSCameraRigParams& A, const FALSCameraRigParams& B,
+                                              const float Alpha)
+{
+	FALSCameraRigParams Result;
+	Result.RotationLagSpeed = FMath::Lerp(A.RotationLagSpeed, B.RotationLagSpeed, Alpha);
+	Result.PivotLagSpeed = FMath::Lerp(A.PivotLagSpeed, B.PivotLagSpeed, Alpha);
+	Result.PivotOffset = FMath::Lerp(A.PivotOffset, B.PivotOffset, Alpha);
+	Result.CameraOffset = FMath::Lerp(A.CameraOffset, B.CameraOffset, Alpha);
+	Result.Weight_FirstPerson = FMath::Lerp(A.Weight_FirstPerson, B.Weight_FirstPerson, Alpha);
+	Result.Override_Debug = FMath::Lerp(A.Override_Debug, B.Override_Debug, Alpha);
+	return Result;
+}
+
+bool FALSCameraRigState::Matches(const EALSMovementState MovementState, const EALSGait Gait, const EALSStance Stance,
+                                 const EALSRotationMode RotationMode, const EALSViewMode ViewMode) const
+{
+	return MaskMatches(MovementStates, MovementState) && MaskMatches(Gaits, Gait) && MaskMatches(Stances, Stance) &&
+		MaskMatches(RotationModes, RotationMode) && MaskMatches(ViewModes, ViewMode);
+}
+
+int32 UALSCameraRigPreset::FindState(const EALSMovementState MovementState, const EALSGait Gait,
+                                     const EALSStance Stance, const EALSRotationMode RotationMode,
+                                     const EALSViewMode ViewMode) const
+{
+	return States.IndexOfByPredicate([&](const FALSCameraRigState& State)
+	{
+		return State.Matches(MovementState, Gait, Stance, RotationMode, ViewMode);
+	});
+}
+
+const FALSCameraRigParams& UALSCameraRigPreset::GetParams(const int32 StateIndex) const
+{
+	return States.IsValidIndex(StateIndex) ? States[StateIndex].Params : DefaultParams;
+}
+
+float UALSCameraRigPreset::GetBlendTime(const int32 StateIndex) const
+{
+	if (States.IsValidIndex(StateIndex) && States[StateIndex].BlendTime >= 0.0f)
+	{
+		return States[StateIndex].BlendTime;
+	}
+	return DefaultBlendTime;
+}
+
+float UALSCameraRigPreset::GetBlendAlpha(const int32 StateIndex, const float Time) const
+{
+	const UCurveFloat* Curve = States.IsValidIndex(StateIndex) && States[StateIndex].BlendCurve
+		                           ? States[StateIndex].BlendCurve.Get()
+		                           : DefaultBlendCurve.Get();
+
+	return Curve ? Curve->GetFloatValue(Time) : FMath::SmoothStep(0.0f, 1.0f, Time);
+}
@@ -0,0 +1,36 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Data/ALSNetAssetRegistry.h"
+
+#include "Animation/AnimMontage.h"
+#include "Engine/SkeletalMesh.h"
+
+namespace ALS::NetAssetRegistry
+{
+	template <typename T>
+	uint8 FindID(const TArray<TObjectPtr<T>>& Assets, const T* Asset)
+	{
+		const int32 Index = Asset ? Assets.IndexOfByKey(Asset) : INDEX_NONE;
+		return Index >= 0 && Index < UALSNetAssetRegistry::InvalidID ? static_cast<uint8>(Index) : UALSNetAssetRegistry::InvalidID;
+	}
+}
+
+uint8 UALSNetAssetRegistry::GetMontageID(const UAnimMontage* Montage) const
+{
+	return ALS::NetAssetRegistry::FindID(Montages, Montage);
+}
+
+UAnimMontage* UALSNetAssetRegistry::GetMontage(const uint8 ID) const
+{
+	return ID != InvalidID && Montages.IsValidIndex(ID) ? Montages[ID] : nullptr;
+}
+
+uint8 UALSNetAssetRegistry::GetMeshID(const USkeletalMesh* Mesh) const
+{
+	return ALS::NetAssetRegistry::FindID(Meshes, Mesh);
+}
+
+USkeletalMesh* UALSNetAssetRegistry::GetMesh(const uint8 ID) const
+{
+	return ID != InvalidID && Meshes.IsValidIndex(ID) ? Meshes[ID] : nullptr;
+}
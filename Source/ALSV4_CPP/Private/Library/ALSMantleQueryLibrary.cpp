@@ -0,0 +1,228 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Library/ALSMantleQueryLibrary.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Library/ALSMathLibrary.h"
+#include "Navigation/NavLinkProxy.h"
+
+namespace ALS::MantleQuery
+{
+	static bool IsWalkable(const FHitResult& Hit, const FALSMantleQuerySettings& Settings)
+	{
+		if (Settings.MovementComponent)
+		{
+			return Settings.MovementComponent->IsWalkable(Hit);
+		}
+
+		// Same as UCharacterMovementComponent::IsWalkable.
+		if (!Hit.IsValidBlockingHit() || Hit.ImpactNormal.Z < KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		float WalkableFloorZ = Settings.WalkableFloorZ;
+		if (const UPrimitiveComponent* Component = Hit.Component.Get())
+		{
+			WalkableFloorZ = Component->GetWalkableSlopeOverride().ModifyWalkableFloorZ(WalkableFloorZ);
+		}
+
+		return Hit.ImpactNormal.Z >= WalkableFloorZ;
+	}
+}
+
+using namespace ALS::MantleQuery;
+
+void UALSMantleQueryLibrary::QueryMantleOpportunities(const UObject* WorldContextObject,
+                                                      const TArray<FALSMantleQuery>& Queries,
+                                                      const FALSMantleQuerySettings& Settings,
+                                                      TArray<FALSMantleQueryResult>& OutResults)
+{
+	OutResults.Reset();
+	OutResults.SetNum(Queries.Num());
+
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return;
+	}
+
+	ParallelFor(Queries.Num(), [&](const int32 Index)
+	{
+		OutResults[Index] = QueryMantleOpportunity(World, Queries[Index], Settings);
+	});
+}
+
+TArray<ANavLinkProxy*> UALSMantleQueryLibrary::SpawnMantleNavLinks(const UObject* WorldContextObject,
+                                                                   const TArray<FALSMantleQuery>& Queries,
+                                                                   const TArray<FALSMantleQueryResult>& Results,
+                                                                   const FALSMantleQuerySettings& Settings,
+                                                                   const TSubclassOf<ANavLinkProxy> LinkClass)
+{
+	TArray<ANavLinkProxy*> Links;
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World || Queries.Num() != Results.Num())
+	{
+		return Links;
+	}
+
+	UClass* Class = LinkClass ? LinkClass.Get() : ANavLinkProxy::StaticClass();
+
+	for (int32 i = 0; i < Results.Num(); ++i)
+	{
+		if (!Results[i].bCanMantle)
+		{
+			continue;
+		}
+
+		const FVector Ground = Queries[i].Location - FVector(0.0f, 0.0f, Settings.CapsuleHalfHeight);
+		const FTransform SpawnTransform(Ground);
+
+		// Links are picked up by navigation when the proxy registers, so set them before finishing the spawn.
+		ANavLinkProxy* Link = World->SpawnActorDeferred<ANavLinkProxy>(Class, SpawnTransform);
+		if (!Link)
+		{
+			continue;
+		}
+
+		Link->PointLinks.Reset();
+		FNavigationLink& PointLink = Link->PointLinks.AddDefaulted_GetRef();
+		PointLink.Left = FVector::ZeroVector;
+		PointLink.Right = Results[i].LedgeLocation - Ground;
+		PointLink.Direction = ENavLinkDirection::LeftToRight;
+
+		Link->FinishSpawning(SpawnTransform);
+		Links.Add(Link);
+	}
+
+	return Links;
+}
+
+FALSMantleQuerySettings UALSMantleQueryLibrary::MakeMantleQuerySettings(const ACharacter* Character,
+                                                                       const FALSMantleTraceSettings& TraceSettings)
+{
+	FALSMantleQuerySettings Settings;
+	Settings.TraceSettings = TraceSettings;
+
+	if (IsValid(Character))
+	{
+		Settings.CapsuleRadius = Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		Settings.CapsuleHalfHeight = Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		Settings.MovementComponent = Character->GetCharacterMovement();
+		if (Settings.MovementComponent)
+		{
+			Settings.WalkableFloorZ = Settings.MovementComponent->GetWalkableFloorZ();
+		}
+	}
+
+	return Settings;
+}
+
+FALSMantleQueryResult UALSMantleQueryLibrary::QueryMantleOpportunity(const UWorld* World,
+                                                                     const FALSMantleQuery& Query,
+                                                                     const FALSMantleQuerySettings& Settings)
+{
+	FALSMantleQueryResult Result;
+
+	const FALSMantleTraceSettings& TraceSettings = Settings.TraceSettings;
+	const FVector TraceDirection = FVector(FVector2D(Query.Direction).GetSafeNormal(), 0.0f);
+	if (TraceDirection.IsZero())
+	{
+		return Result;
+	}
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSMantleQuery));
+	FVector TraceStart;
+	FVector TraceEnd;
+	FCollisionShape CollisionShape;
+
+	// Step 1: Trace forward to find a wall / object the character cannot walk on.
+	const FVector CapsuleBaseLocation = Query.Location - FVector(0.0f, 0.0f, Settings.CapsuleHalfHeight + 2.0f);
+	GetForwardTrace(TraceSettings, CapsuleBaseLocation, TraceDirection, TraceStart, TraceEnd, CollisionShape);
+
+	FHitResult HitResult;
+	World->SweepSingleByProfile(HitResult, TraceStart, TraceEnd, FQuat::Identity,
+	                            Settings.MantleObjectDetectionProfile, CollisionShape, Params);
+
+	if (!HitResult.IsValidBlockingHit() || IsWalkable(HitResult, Settings))
+	{
+		return Result;
+	}
+
+	const FVector InitialTraceNormal = HitResult.ImpactNormal;
+
+	// Step 2: Trace downward from the first trace's Impact Point and determine if the hit location is walkable.
+	GetDownwardTrace(TraceSettings, CapsuleBaseLocation, HitResult.ImpactPoint, InitialTraceNormal, TraceStart,
+	                 TraceEnd, CollisionShape);
+
+	World->SweepSingleByChannel(HitResult, TraceStart, TraceEnd, FQuat::Identity,
+	                            Settings.WalkableSurfaceDetectionChannel, CollisionShape, Params);
+
+	if (!IsWalkable(HitResult, Settings))
+	{
+		return Result;
+	}
+
+	const FVector DownTraceLocation(HitResult.Location.X, HitResult.Location.Y, HitResult.ImpactPoint.Z);
+	const FVector CapsuleLocationFBase = DownTraceLocation + FVector(0.0f, 0.0f, Settings.CapsuleHalfHeight + 2.0f);
+
+	// Step 3: Check if the capsule has room to stand at the downward trace's location.
+	float Radius;
+	UALSMathLibrary::GetCapsuleHasRoomTrace(CapsuleLocationFBase, Settings.CapsuleRadius, Settings.CapsuleHalfHeight,
+	                                        0.0f, 0.0f, TraceStart, TraceEnd, Radius);
+	const bool bBlocked = World->SweepSingleByChannel(HitResult, TraceStart, TraceEnd, FQuat::Identity, ECC_Visibility,
+	                                                  FCollisionShape::MakeSphere(Radius), Params);
+
+	if (bBlocked || HitResult.bStartPenetrating)
+	{
+		return Result;
+	}
+
+	// Step 4: Determine the Mantle Type by the falling state and Mantle Height.
+	Result.bCanMantle = true;
+	Result.MantleHeight = (CapsuleLocationFBase - Query.Location).Z;
+	Result.Target = FTransform((InitialTraceNormal * FVector(-1.0f, -1.0f, 0.0f)).ToOrientationRotator(),
+	                           CapsuleLocationFBase, FVector::OneVector);
+	Result.LedgeLocation = DownTraceLocation;
+
+	if (Query.bFalling)
+	{
+		Result.MantleType = EALSMantleType::FallingCatch;
+	}
+	else
+	{
+		Result.MantleType = Result.MantleHeight > 125.0f ? EALSMantleType::HighMantle : EALSMantleType::LowMantle;
+	}
+
+	return Result;
+}
+
+void UALSMantleQueryLibrary::GetForwardTrace(const FALSMantleTraceSettings& TraceSettings,
+                                             const FVector& CapsuleBaseLocation, const FVector& TraceDirection,
+                                             FVector& OutStart, FVector& OutEnd, FCollisionShape& OutShape)
+{
+	OutStart = CapsuleBaseLocation + TraceDirection * -30.0f;
+	OutStart.Z += (TraceSettings.MaxLedgeHeight + TraceSettings.MinLedgeHeight) / 2.0f;
+	OutEnd = OutStart + TraceDirection * TraceSettings.ReachDistance;
+	const float HalfHeight = 1.0f + (TraceSettings.MaxLedgeHeight - TraceSettings.MinLedgeHeight) / 2.0f;
+	OutShape = FCollisionShape::MakeCapsule(TraceSettings.ForwardTraceRadius, HalfHeight);
+}
+
+void UALSMantleQueryLibrary::GetDownwardTrace(const FALSMantleTraceSettings& TraceSettings,
+                                              const FVector& CapsuleBaseLocation, const FVector& ImpactPoint,
+                                              const FVector& ImpactNormal, FVector& OutStart, FVector& OutEnd,
+                                              FCollisionShape& OutShape)
+{
+	OutEnd = ImpactPoint;
+	OutEnd.Z = CapsuleBaseLocation.Z;
+	OutEnd += ImpactNormal * -15.0f;
+	OutStart = OutEnd;
+	OutStart.Z += TraceSettings.MaxLedgeHeight + TraceSettings.DownwardTraceRadius + 1.0f;
+	OutShape = FCollisionShape::MakeSphere(TraceSettings.DownwardTraceRadius);
+}
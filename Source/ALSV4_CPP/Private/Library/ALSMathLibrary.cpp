@@ -32,16 +32,28 @@ FVector UALSMathLibrary::GetCapsuleLocationFromBase(FVector BaseLocation, const
 	return BaseLocation;
 }
 
+void UALSMathLibrary::GetCapsuleHasRoomTrace(const FVector& TargetLocation, const float CapsuleRadius,
+                                             const float CapsuleHalfHeight, const float HeightOffset,
+                                             const float RadiusOffset, FVector& OutStart, FVector& OutEnd,
+                                             float& OutRadius)
+{
+	const float ZTarget = CapsuleHalfHeight - CapsuleRadius - RadiusOffset + HeightOffset;
+	OutStart = TargetLocation;
+	OutStart.Z += ZTarget;
+	OutEnd = TargetLocation;
+	OutEnd.Z -= ZTarget;
+	OutRadius = CapsuleRadius + RadiusOffset;
+}
+
 bool UALSMathLibrary::CapsuleHasRoomCheck(UCapsuleComponent* Capsule, FVector TargetLocation, float HeightOffset,
                                           float RadiusOffset, EDrawDebugTrace::Type DebugType, bool DrawDebugTrace)
 {
 	// Perform a trace to see if the capsule has room to be at the target location.
-	const float ZTarget = Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere() - RadiusOffset + HeightOffset;
-	FVector TraceStart = TargetLocation;
-	TraceStart.Z += ZTarget;
-	FVector TraceEnd = TargetLocation;
-	TraceEnd.Z -= ZTarget;
-	const float Radius = Capsule->GetUnscaledCapsuleRadius() + RadiusOffset;
+	FVector TraceStart;
+	FVector TraceEnd;
+	float Radius;
+	GetCapsuleHasRoomTrace(TargetLocation, Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight(),
+	                       HeightOffset, RadiusOffset, TraceStart, TraceEnd, Radius);
 
 	const UWorld* World = Capsule->GetWorld();
 	check(World);
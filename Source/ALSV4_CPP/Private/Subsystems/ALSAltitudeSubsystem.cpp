@@ -0,0 +1,138 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Subsystems/ALSAltitudeSubsystem.h"
+
+#include "ALS_Settings.h"
+#include "Engine/Level.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/World.h"
+
+namespace ALS::Altitude
+{
+	// Ground height of cells without any ground, e.g. over open sea below SeaAltitude.
+	static constexpr float NoGroundHeight = -HALF_WORLD_MAX;
+}
+
+using namespace ALS::Altitude;
+
+void UALSAltitudeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = UALS_Settings::Get()->AltitudeGridCellSize;
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UALSAltitudeSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UALSAltitudeSubsystem::OnLevelRemoved);
+}
+
+void UALSAltitudeSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	GroundHeights.Reset();
+	LevelBounds.Reset();
+
+	Super::Deinitialize();
+}
+
+float UALSAltitudeSubsystem::GetGroundHeight(const FVector& Location)
+{
+	const FIntPoint Cell(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+
+	if (const float* Height = GroundHeights.Find(Cell))
+	{
+		return *Height;
+	}
+
+	return GroundHeights.Add(Cell, BuildCell(Cell));
+}
+
+void UALSAltitudeSubsystem::InvalidateRegion(const FBox& Bounds)
+{
+	const int32 MinX = FMath::FloorToInt(Bounds.Min.X / CellSize);
+	const int32 MinY = FMath::FloorToInt(Bounds.Min.Y / CellSize);
+	const int32 MaxX = FMath::FloorToInt(Bounds.Max.X / CellSize);
+	const int32 MaxY = FMath::FloorToInt(Bounds.Max.Y / CellSize);
+
+	for (auto It = GroundHeights.CreateIterator(); It; ++It)
+	{
+		const FIntPoint& Cell = It.Key();
+		if (Cell.X >= MinX && Cell.X <= MaxX && Cell.Y >= MinY && Cell.Y <= MaxY)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UALSAltitudeSubsystem::InvalidateAll()
+{
+	GroundHeights.Reset();
+}
+
+float UALSAltitudeSubsystem::BuildCell(const FIntPoint& Cell) const
+{
+	const UALS_Settings* Settings = UALS_Settings::Get();
+
+	// Only static geometry, so characters and other movables passing by don't end up in the cache.
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSAltitudeCell));
+	Params.MobilityType = EQueryMobilityType::Static;
+
+	// A flat box over the whole cell footprint, swept down, first touches the highest geometry anywhere in the cell.
+	// Point samples could miss narrow spires between them.
+	const FVector2D Center = (FVector2D(Cell) + FVector2D(0.5, 0.5)) * CellSize;
+	const FVector Start(Center, Settings->TroposphereHeight);
+	const FVector End(Center, NoGroundHeight);
+	const FCollisionShape Footprint = FCollisionShape::MakeBox(FVector(CellSize * 0.5f, CellSize * 0.5f, 1.0f));
+
+	FHitResult HitResult;
+	if (!GetWorld()->SweepSingleByChannel(HitResult, Start, End, FQuat::Identity, Settings->FlightCheckChannel,
+	                                      Footprint, Params))
+	{
+		return NoGroundHeight;
+	}
+
+	// Geometry reaching above the troposphere.
+	if (HitResult.bStartPenetrating)
+	{
+		return static_cast<float>(Start.Z);
+	}
+
+	return static_cast<float>(HitResult.ImpactPoint.Z);
+}
+
+void UALSAltitudeSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || !Level)
+	{
+		return;
+	}
+
+	const FBox Bounds = ALevelBounds::CalculateLevelBounds(Level);
+	if (Bounds.IsValid)
+	{
+		LevelBounds.Add(Level, Bounds);
+		InvalidateRegion(Bounds);
+	}
+}
+
+void UALSAltitudeSubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// A null level means all levels were removed.
+	if (!Level)
+	{
+		InvalidateAll();
+		LevelBounds.Reset();
+		return;
+	}
+
+	FBox Bounds(ForceInit);
+	if (LevelBounds.RemoveAndCopyValue(Level, Bounds))
+	{
+		InvalidateRegion(Bounds);
+	}
+}
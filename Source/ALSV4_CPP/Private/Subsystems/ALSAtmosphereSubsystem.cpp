@@ -0,0 +1,97 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Subsystems/ALSAtmosphereSubsystem.h"
+
+#include "ALS_Settings.h"
+#include "Volumes/ALSAtmosphereVolume.h"
+
+void UALSAtmosphereSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UALS_Settings* Settings = UALS_Settings::Get();
+	SeaAltitude = Settings->SeaAltitude;
+	TroposphereHeight = FMath::Max(Settings->TroposphereHeight, SeaAltitude + 1.0f);
+
+	// Exponential falloff, faded out towards the troposphere so that flight can't be maintained at its top.
+	const float Range = TroposphereHeight - SeaAltitude;
+	DensityTable.SetNumUninitialized(DensityTableSize);
+	for (int32 i = 0; i < DensityTableSize; ++i)
+	{
+		const float Alpha = static_cast<float>(i) / (DensityTableSize - 1);
+		DensityTable[i] = FMath::Exp(-Alpha * Range / Settings->AtmosphereScaleHeight) * (1.0f - Alpha);
+	}
+}
+
+FALSAtmosphereSample UALSAtmosphereSubsystem::Sample(const FVector& Location) const
+{
+	FALSAtmosphereSample Result;
+	Result.Density = GetDensityAtAltitude(Location.Z);
+
+	if (const TArray<TWeakObjectPtr<AALSAtmosphereVolume>>* Volumes = VolumeCells.Find(GetCell(Location)))
+	{
+		for (const TWeakObjectPtr<AALSAtmosphereVolume>& WeakVolume : *Volumes)
+		{
+			const AALSAtmosphereVolume* Volume = WeakVolume.Get();
+			if (Volume && Volume->GetCachedBounds().IsInsideOrOn(Location) && Volume->EncompassesPoint(Location))
+			{
+				Result.Density *= Volume->DensityScale;
+				Result.UpdraftAcceleration += Volume->UpdraftAcceleration;
+				Result.bNoFly |= Volume->bNoFly;
+			}
+		}
+	}
+
+	return Result;
+}
+
+float UALSAtmosphereSubsystem::GetDensityAtAltitude(const float Altitude) const
+{
+	const float Position = FMath::Clamp((Altitude - SeaAltitude) / (TroposphereHeight - SeaAltitude), 0.0f, 1.0f) *
+		(DensityTableSize - 1);
+	const int32 Index = FMath::Min(FMath::FloorToInt(Position), DensityTableSize - 2);
+	return FMath::Lerp(DensityTable[Index], DensityTable[Index + 1], Position - Index);
+}
+
+void UALSAtmosphereSubsystem::RegisterVolume(AALSAtmosphereVolume* Volume)
+{
+	const FBox& Bounds = Volume->GetCachedBounds();
+	const FIntPoint Min = GetCell(Bounds.Min);
+	const FIntPoint Max = GetCell(Bounds.Max);
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			VolumeCells.FindOrAdd(FIntPoint(X, Y)).AddUnique(Volume);
+		}
+	}
+}
+
+void UALSAtmosphereSubsystem::UnregisterVolume(AALSAtmosphereVolume* Volume)
+{
+	const FBox& Bounds = Volume->GetCachedBounds();
+	const FIntPoint Min = GetCell(Bounds.Min);
+	const FIntPoint Max = GetCell(Bounds.Max);
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			const FIntPoint Cell(X, Y);
+			if (TArray<TWeakObjectPtr<AALSAtmosphereVolume>>* Volumes = VolumeCells.Find(Cell))
+			{
+				Volumes->Remove(Volume);
+				if (Volumes->IsEmpty())
+				{
+					VolumeCells.Remove(Cell);
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UALSAtmosphereSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / VolumeCellSize), FMath::FloorToInt(Location.Y / VolumeCellSize));
+}
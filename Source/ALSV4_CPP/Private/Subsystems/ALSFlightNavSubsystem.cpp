@@ -0,0 +1,497 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Subsystems/ALSFlightNavSubsystem.h"
+
+#include "Algo/Reverse.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "Volumes/ALSFlightNavVolume.h"
+
+namespace ALS::FlightNav
+{
+	static int32 GetOctant(const FVector& Center, const FVector& Point)
+	{
+		return (Point.X >= Center.X ? 1 : 0) | (Point.Y >= Center.Y ? 2 : 0) | (Point.Z >= Center.Z ? 4 : 0);
+	}
+
+	static FBox GetNodeBox(const FALSFlightNavNode& Node)
+	{
+		return FBox(Node.Center - FVector(Node.HalfSize), Node.Center + FVector(Node.HalfSize));
+	}
+
+	// Nodes further apart than this are not looked at when straightening a path.
+	static constexpr int32 MaxStraightenLookahead = 16;
+
+	// Nodes visited when searching for a random reachable point.
+	static constexpr int32 MaxRandomPointNodes = 1024;
+}
+
+using namespace ALS::FlightNav;
+
+int32 FALSFlightNavOctree::FindNavigableNode(const FVector& Point) const
+{
+	const int32 Index = FindNode(Point, 0.0f);
+	return Index != INDEX_NONE && Nodes[Index].IsNavigable() ? Index : INDEX_NONE;
+}
+
+int32 FALSFlightNavOctree::FindNearestNavigableNode(const FVector& Point) const
+{
+	int32 Index = FindNavigableNode(Point);
+	float ClosestDistanceSquared = MAX_flt;
+
+	for (int32 X = -1; X <= 1 && Index == INDEX_NONE; ++X)
+	{
+		for (int32 Y = -1; Y <= 1; ++Y)
+		{
+			for (int32 Z = -1; Z <= 1; ++Z)
+			{
+				const FVector Offset = FVector(X, Y, Z) * VoxelSize;
+				const int32 Candidate = FindNavigableNode(Point + Offset);
+				if (Candidate != INDEX_NONE && Offset.SizeSquared() < ClosestDistanceSquared)
+				{
+					Index = Candidate;
+					ClosestDistanceSquared = Offset.SizeSquared();
+				}
+			}
+		}
+	}
+
+	return Index;
+}
+
+int32 FALSFlightNavOctree::FindNode(const FVector& Point, const float MinHalfSize) const
+{
+	if (Nodes.IsEmpty() || !GetNodeBox(Nodes[0]).IsInsideOrOn(Point))
+	{
+		return INDEX_NONE;
+	}
+
+	int32 Index = 0;
+	while (!Nodes[Index].IsLeaf() && Nodes[Index].HalfSize > MinHalfSize)
+	{
+		Index = Nodes[Index].FirstChild + GetOctant(Nodes[Index].Center, Point);
+	}
+	return Index;
+}
+
+bool FALSFlightNavOctree::FindPath(const FVector& Start, const FVector& End, const int32 MaxIterations,
+                                   TArray<FVector>& OutPath) const
+{
+	OutPath.Reset();
+
+	const int32 StartNode = FindNearestNavigableNode(Start);
+	const int32 EndNode = FindNearestNavigableNode(End);
+	if (StartNode == INDEX_NONE || EndNode == INDEX_NONE)
+	{
+		return false;
+	}
+
+	struct FRecord
+	{
+		float Cost;
+		int32 Parent;
+		bool bClosed;
+	};
+
+	struct FOpenNode
+	{
+		float Estimate;
+		int32 Node;
+
+		bool operator<(const FOpenNode& Other) const { return Estimate < Other.Estimate; }
+	};
+
+	const FVector& Goal = Nodes[EndNode].Center;
+
+	TMap<int32, FRecord> Records;
+	TArray<FOpenNode> Open;
+	Records.Add(StartNode, {0.0f, INDEX_NONE, false});
+	Open.HeapPush({FVector::Dist(Nodes[StartNode].Center, Goal), StartNode});
+
+	bool bFound = false;
+	for (int32 Iteration = 0; !Open.IsEmpty() && Iteration < MaxIterations; ++Iteration)
+	{
+		FOpenNode Current;
+		Open.HeapPop(Current, false);
+
+		FRecord& Record = Records.FindChecked(Current.Node);
+		if (Record.bClosed)
+		{
+			continue;
+		}
+		Record.bClosed = true;
+
+		if (Current.Node == EndNode)
+		{
+			bFound = true;
+			break;
+		}
+
+		// Copied, as adding records below may reallocate.
+		const float Cost = Record.Cost;
+		const FALSFlightNavNode& Node = Nodes[Current.Node];
+
+		for (int32 i = 0; i < Node.NumNeighbors; ++i)
+		{
+			const int32 Neighbor = Neighbors[Node.FirstNeighbor + i];
+			const float NewCost = Cost + FVector::Dist(Node.Center, Nodes[Neighbor].Center);
+
+			const FRecord* NeighborRecord = Records.Find(Neighbor);
+			if (NeighborRecord && (NeighborRecord->bClosed || NeighborRecord->Cost <= NewCost))
+			{
+				continue;
+			}
+
+			Records.Add(Neighbor, {NewCost, Current.Node, false});
+			Open.HeapPush({NewCost + FVector::Dist(Nodes[Neighbor].Center, Goal), Neighbor});
+		}
+	}
+
+	if (!bFound)
+	{
+		return false;
+	}
+
+	// Walk back through the node centers, passing between two nodes through their shared face so that every
+	// segment stays inside a navigable node.
+	TArray<FVector> Points;
+	Points.Add(End);
+	int32 Previous = EndNode;
+	for (int32 Node = Records[EndNode].Parent; Node != INDEX_NONE; Node = Records[Node].Parent)
+	{
+		const FBox Portal = GetNodeBox(Nodes[Node]).Overlap(GetNodeBox(Nodes[Previous]).ExpandBy(KINDA_SMALL_NUMBER));
+		Points.Add(Portal.GetClosestPointTo((Nodes[Node].Center + Nodes[Previous].Center) * 0.5f));
+		if (Node != StartNode)
+		{
+			Points.Add(Nodes[Node].Center);
+		}
+		Previous = Node;
+	}
+	Points.Add(Start);
+	Algo::Reverse(Points);
+
+	// Skip points that can be flown past in a straight line.
+	OutPath.Add(Points[0]);
+	int32 CurrentPoint = 0;
+	while (CurrentPoint < Points.Num() - 1)
+	{
+		int32 NextPoint = FMath::Min(CurrentPoint + MaxStraightenLookahead, Points.Num() - 1);
+		while (NextPoint > CurrentPoint + 1 && !IsSegmentClear(Points[CurrentPoint], Points[NextPoint]))
+		{
+			NextPoint--;
+		}
+		OutPath.Add(Points[NextPoint]);
+		CurrentPoint = NextPoint;
+	}
+
+	return true;
+}
+
+bool FALSFlightNavOctree::GetRandomReachablePoint(const FVector& Origin, const float Radius, FVector& OutPoint) const
+{
+	const int32 StartNode = FindNearestNavigableNode(Origin);
+	if (StartNode == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FBox SearchBox(Origin - FVector(Radius), Origin + FVector(Radius));
+
+	TArray<int32> Reached;
+	TSet<int32> Visited;
+	Reached.Add(StartNode);
+	Visited.Add(StartNode);
+
+	for (int32 i = 0; i < Reached.Num() && Reached.Num() < MaxRandomPointNodes; ++i)
+	{
+		const FALSFlightNavNode& Node = Nodes[Reached[i]];
+		for (int32 j = 0; j < Node.NumNeighbors; ++j)
+		{
+			const int32 Neighbor = Neighbors[Node.FirstNeighbor + j];
+			if (!Visited.Contains(Neighbor) && GetNodeBox(Nodes[Neighbor]).Intersect(SearchBox))
+			{
+				Visited.Add(Neighbor);
+				Reached.Add(Neighbor);
+			}
+		}
+	}
+
+	const FALSFlightNavNode& Node = Nodes[Reached[FMath::RandHelper(Reached.Num())]];
+	OutPoint = FMath::RandPointInBox(GetNodeBox(Node).Overlap(SearchBox));
+	return true;
+}
+
+bool FALSFlightNavOctree::IsSegmentClear(const FVector& Start, const FVector& End) const
+{
+	FVector Direction;
+	float Length;
+	(End - Start).ToDirectionAndLength(Direction, Length);
+
+	// Step from node to node along the segment instead of sampling at a fixed interval, so large free nodes are
+	// crossed in one step.
+	float Distance = 0.0f;
+	while (true)
+	{
+		const FVector Point = Start + Direction * Distance;
+		const int32 Index = FindNavigableNode(Point);
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		if (Distance >= Length)
+		{
+			return true;
+		}
+
+		const FALSFlightNavNode& Node = Nodes[Index];
+		float Exit = Length;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (FMath::Abs(Direction[Axis]) > SMALL_NUMBER)
+			{
+				const float Bound = Node.Center[Axis] + (Direction[Axis] > 0.0f ? Node.HalfSize : -Node.HalfSize);
+				Exit = FMath::Min(Exit, (Bound - Point[Axis]) / Direction[Axis]);
+			}
+		}
+
+		Distance = FMath::Min(Distance + FMath::Max(Exit, 0.0f) + VoxelSize * 0.05f, Length);
+	}
+}
+
+void FALSFlightNavOctree::GatherNeighbors(const int32 NodeIndex, TArray<int32>& OutNeighbors) const
+{
+	const FALSFlightNavNode& Node = Nodes[NodeIndex];
+
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		for (const bool bPositive : {false, true})
+		{
+			// Leaves are never smaller than a quarter voxel, so this probe lands in the adjacent node.
+			FVector Probe = Node.Center;
+			Probe[Axis] += (bPositive ? 1.0f : -1.0f) * (Node.HalfSize + VoxelSize * 0.1f);
+
+			const int32 Other = FindNode(Probe, Node.HalfSize);
+			if (Other != INDEX_NONE)
+			{
+				GatherFaceNodes(Other, Axis, !bPositive, OutNeighbors);
+			}
+		}
+	}
+}
+
+void FALSFlightNavOctree::GatherFaceNodes(const int32 NodeIndex, const int32 Axis, const bool bPositiveSide,
+                                          TArray<int32>& OutNodes) const
+{
+	const FALSFlightNavNode& Node = Nodes[NodeIndex];
+	if (Node.IsLeaf())
+	{
+		if (!Node.bBlocked)
+		{
+			OutNodes.Add(NodeIndex);
+		}
+		return;
+	}
+
+	for (int32 Octant = 0; Octant < 8; ++Octant)
+	{
+		if (((Octant >> Axis) & 1) == (bPositiveSide ? 1 : 0))
+		{
+			GatherFaceNodes(Node.FirstChild + Octant, Axis, bPositiveSide, OutNodes);
+		}
+	}
+}
+
+void UALSFlightNavSubsystem::Deinitialize()
+{
+	// Queries in flight keep their octree alive on their own.
+	Builds.Reset();
+	Octrees.Reset();
+
+	Super::Deinitialize();
+}
+
+void UALSFlightNavSubsystem::Tick(const float DeltaTime)
+{
+	// One volume at a time, so the budget holds with many volumes.
+	FBuild& Build = Builds[0];
+	const AALSFlightNavVolume* Volume = Build.Volume.Get();
+	const double EndTime = FPlatformTime::Seconds() + (Volume ? Volume->BuildBudgetMs : 1.0f) / 1000.0;
+
+	if (ContinueBuild(Build, EndTime))
+	{
+		if (Volume)
+		{
+			Octrees.Add(Build.Volume, Build.Octree);
+		}
+		Builds.RemoveAt(0);
+	}
+}
+
+ETickableTickType UALSFlightNavSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UALSFlightNavSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UALSFlightNavSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSFlightNavSubsystem, STATGROUP_Tickables);
+}
+
+void UALSFlightNavSubsystem::RequestBuild(AALSFlightNavVolume* Volume)
+{
+	Builds.RemoveAll([Volume](const FBuild& Build) { return Build.Volume == Volume; });
+
+	const FBox Bounds = Volume->GetComponentsBoundingBox(true);
+
+	FBuild& Build = Builds.AddDefaulted_GetRef();
+	Build.Volume = Volume;
+	Build.Octree = MakeShared<FALSFlightNavOctree, ESPMode::ThreadSafe>();
+	Build.Octree->Bounds = Bounds;
+	Build.Octree->VoxelSize = Volume->VoxelSize;
+
+	FALSFlightNavNode& Root = Build.Octree->Nodes.AddDefaulted_GetRef();
+	Root.Center = Bounds.GetCenter();
+	Root.HalfSize = Bounds.GetExtent().GetMax();
+	Build.PendingNodes.Add(0);
+}
+
+void UALSFlightNavSubsystem::RemoveVolume(AALSFlightNavVolume* Volume)
+{
+	Builds.RemoveAll([Volume](const FBuild& Build) { return Build.Volume == Volume; });
+	Octrees.Remove(Volume);
+}
+
+FALSFlightNavQueryPtr UALSFlightNavSubsystem::FindPathAsync(const FVector& Start, const FVector& End,
+                                                            const int32 MaxIterations) const
+{
+	FALSFlightNavOctreePtr Octree = FindOctree(Start);
+	if (!Octree)
+	{
+		return nullptr;
+	}
+
+	FALSFlightNavQueryPtr Query = MakeShared<FALSFlightNavQuery, ESPMode::ThreadSafe>();
+	Query->Start = Start;
+	Query->End = End;
+
+	Async(EAsyncExecution::ThreadPool, [Octree, Query, MaxIterations]
+	{
+		Query->bSuccess = Octree->FindPath(Query->Start, Query->End, MaxIterations, Query->Path);
+		Query->bComplete = true;
+	});
+
+	return Query;
+}
+
+bool UALSFlightNavSubsystem::GetRandomReachablePoint(const FVector& Origin, const float Radius, FVector& OutPoint) const
+{
+	const FALSFlightNavOctreePtr Octree = FindOctree(Origin);
+	return Octree && Octree->GetRandomReachablePoint(Origin, Radius, OutPoint);
+}
+
+FALSFlightNavOctreePtr UALSFlightNavSubsystem::FindOctree(const FVector& Location) const
+{
+	for (const TPair<TWeakObjectPtr<AALSFlightNavVolume>, FALSFlightNavOctreePtr>& Pair : Octrees)
+	{
+		if (Pair.Value->Bounds.IsInsideOrOn(Location))
+		{
+			return Pair.Value;
+		}
+	}
+	return nullptr;
+}
+
+bool UALSFlightNavSubsystem::ContinueBuild(FBuild& Build, const double EndTime) const
+{
+	const AALSFlightNavVolume* Volume = Build.Volume.Get();
+	if (!Volume)
+	{
+		return true;
+	}
+
+	FALSFlightNavOctree& Octree = *Build.Octree;
+	int32 Steps = 0;
+
+	// Step 1: Classify nodes, subdividing those that touch geometry down to the voxel size.
+	if (!Build.bClassified)
+	{
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSFlightNavBuild));
+		Params.MobilityType = EQueryMobilityType::Static;
+
+		while (!Build.PendingNodes.IsEmpty())
+		{
+			if ((++Steps & 15) == 0 && FPlatformTime::Seconds() >= EndTime)
+			{
+				return false;
+			}
+
+			const int32 Index = Build.PendingNodes.Pop(false);
+			const FVector Center = Octree.Nodes[Index].Center;
+			const float HalfSize = Octree.Nodes[Index].HalfSize;
+
+			if (!GetNodeBox(Octree.Nodes[Index]).Intersect(Octree.Bounds))
+			{
+				Octree.Nodes[Index].bBlocked = true;
+				continue;
+			}
+
+			const FCollisionShape Shape = FCollisionShape::MakeBox(FVector(HalfSize + Volume->AgentRadius));
+			if (!GetWorld()->OverlapBlockingTestByChannel(Center, FQuat::Identity, Volume->CollisionChannel, Shape,
+			                                              Params))
+			{
+				continue;
+			}
+
+			if (HalfSize * 2.0f <= Octree.VoxelSize)
+			{
+				Octree.Nodes[Index].bBlocked = true;
+				continue;
+			}
+
+			const int32 FirstChild = Octree.Nodes.AddDefaulted(8);
+			Octree.Nodes[Index].FirstChild = FirstChild;
+			for (int32 Octant = 0; Octant < 8; ++Octant)
+			{
+				const float Offset = HalfSize * 0.5f;
+				FALSFlightNavNode& Child = Octree.Nodes[FirstChild + Octant];
+				Child.Center = Center + FVector(Octant & 1 ? Offset : -Offset,
+				                                Octant & 2 ? Offset : -Offset,
+				                                Octant & 4 ? Offset : -Offset);
+				Child.HalfSize = Offset;
+				Build.PendingNodes.Add(FirstChild + Octant);
+			}
+		}
+
+		Build.bClassified = true;
+	}
+
+	// Step 2: Link navigable nodes to the navigable nodes they share a face with.
+	TArray<int32> NodeNeighbors;
+	while (Build.NextNeighborNode < Octree.Nodes.Num())
+	{
+		if ((++Steps & 15) == 0 && FPlatformTime::Seconds() >= EndTime)
+		{
+			return false;
+		}
+
+		const int32 Index = Build.NextNeighborNode++;
+		if (!Octree.Nodes[Index].IsNavigable())
+		{
+			continue;
+		}
+
+		NodeNeighbors.Reset();
+		Octree.GatherNeighbors(Index, NodeNeighbors);
+		Octree.Nodes[Index].FirstNeighbor = Octree.Neighbors.Num();
+		Octree.Nodes[Index].NumNeighbors = NodeNeighbors.Num();
+		Octree.Neighbors.Append(NodeNeighbors);
+	}
+
+	return true;
+}
@@ -0,0 +1,121 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Subsystems/ALSHitFXPreloadSubsystem.h"
+
+#include "Character/Animation/Notify/ALSAnimNotifyFootstep.h"
+#include "Engine/AssetManager.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "Library/ALSCharacterStructLibrary.h"
+#include "TimerManager.h"
+#include "UObject/UObjectHash.h"
+
+void UALSHitFXPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UALSHitFXPreloadSubsystem::OnLevelAdded);
+}
+
+void UALSHitFXPreloadSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+
+	for (const TPair<TWeakObjectPtr<UDataTable>, TSharedPtr<FStreamableHandle>>& Pair : TableHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	TableHandles.Reset();
+
+	for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Pair : AssetHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	AssetHandles.Reset();
+
+	Super::Deinitialize();
+}
+
+void UALSHitFXPreloadSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ScanLoadedNotifies();
+}
+
+void UALSHitFXPreloadSubsystem::RequestScan()
+{
+	if (!ScanTimer.IsValid())
+	{
+		ScanTimer = GetWorld()->GetTimerManager().SetTimerForNextTick(this,
+		                                                              &UALSHitFXPreloadSubsystem::ScanLoadedNotifies);
+	}
+}
+
+void UALSHitFXPreloadSubsystem::PreloadHitFX(UDataTable* DataTable)
+{
+	if (!DataTable || TableHandles.Contains(DataTable))
+	{
+		return;
+	}
+
+	TArray<FALSHitFX*> HitFXRows;
+	DataTable->GetAllRows<FALSHitFX>(FString(), HitFXRows);
+
+	TArray<FSoftObjectPath> Paths;
+	for (const FALSHitFX* Row : HitFXRows)
+	{
+		for (const FSoftObjectPath& Path : {
+			     Row->Sound.ToSoftObjectPath(), Row->NiagaraSystem.ToSoftObjectPath(),
+			     Row->DecalMaterial.ToSoftObjectPath()
+		     })
+		{
+			if (Path.IsValid())
+			{
+				Paths.AddUnique(Path);
+			}
+		}
+	}
+
+	// Added even without anything to load, so the table is not scanned again.
+	TableHandles.Add(DataTable, Paths.Num() > 0
+		                            ? UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths))
+		                            : nullptr);
+}
+
+void UALSHitFXPreloadSubsystem::ScanLoadedNotifies()
+{
+	ScanTimer.Invalidate();
+
+	// Footstep notifies are subobjects of the animations that fire them, so all animations in memory are covered.
+	TArray<UObject*> Notifies;
+	GetObjectsOfClass(UALSAnimNotifyFootstep::StaticClass(), Notifies, true, RF_ClassDefaultObject);
+
+	for (const UObject* Object : Notifies)
+	{
+		PreloadHitFX(CastChecked<UALSAnimNotifyFootstep>(Object)->HitDataTable);
+	}
+}
+
+void UALSHitFXPreloadSubsystem::RequestAsset(const FSoftObjectPath& Path)
+{
+	// Also catches rows added to a table after it was preloaded.
+	if (Path.IsValid() && !AssetHandles.Contains(Path))
+	{
+		AssetHandles.Add(Path, UAssetManager::GetStreamableManager().RequestAsyncLoad(Path));
+	}
+}
+
+void UALSHitFXPreloadSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld() && World->HasBegunPlay())
+	{
+		RequestScan();
+	}
+}
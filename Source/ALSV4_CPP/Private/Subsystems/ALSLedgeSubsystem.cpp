@@ -0,0 +1,289 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Subsystems/ALSLedgeSubsystem.h"
+
+#include "Algo/StableSort.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace ALS::Ledge
+{
+	static constexpr uint32 FileMagic = 0x4C534C41; // "ALSL"
+
+	// 2: Ledges of any drop height and of thin obstacles. Version 1 bakes missed both and are not loaded.
+	static constexpr int32 FileVersion = 2;
+}
+
+using namespace ALS::Ledge;
+
+FString FALSLedgeDatabase::GetFilePath(const FString& LevelPackageName)
+{
+	FString RelativeName = LevelPackageName;
+	RelativeName.RemoveFromStart(TEXT("/"));
+
+	// Baked files are not assets, so "ALS/Ledges" has to be added to the additional directories to package.
+	return FPaths::ProjectContentDir() / TEXT("ALS/Ledges") / RelativeName + TEXT(".ledges");
+}
+
+bool FALSLedgeDatabase::Save(const FString& FilePath)
+{
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << Magic << Version << Bounds << CellSize << Spacing << ComponentPaths << Ledges;
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FALSLedgeDatabase::Load(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+
+	FMemoryReader Reader(Bytes);
+	Reader << Magic << Version;
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		return false;
+	}
+
+	Reader << Bounds << CellSize << Spacing << ComponentPaths << Ledges;
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	// Saved sorted already, this only rebuilds the cell ranges.
+	SortLedges();
+	return true;
+}
+
+FIntVector FALSLedgeDatabase::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize),
+	                  FMath::FloorToInt(Location.Y / CellSize),
+	                  FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void FALSLedgeDatabase::SortLedges()
+{
+	auto CellLess = [](const FIntVector& A, const FIntVector& B)
+	{
+		return A.X != B.X ? A.X < B.X : A.Y != B.Y ? A.Y < B.Y : A.Z < B.Z;
+	};
+
+	Algo::StableSort(Ledges, [this, &CellLess](const FALSLedge& A, const FALSLedge& B)
+	{
+		return CellLess(GetCell(FVector(A.Location)), GetCell(FVector(B.Location)));
+	});
+
+	Cells.Reset();
+	for (int32 i = 0; i < Ledges.Num(); ++i)
+	{
+		Cells.FindOrAdd(GetCell(FVector(Ledges[i].Location)), FIntPoint(i, 0)).Y++;
+	}
+}
+
+void UALSLedgeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UALSLedgeSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UALSLedgeSubsystem::OnLevelRemoved);
+}
+
+void UALSLedgeSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	Levels.Reset();
+	UnbakedLevels.Reset();
+
+	Super::Deinitialize();
+}
+
+void UALSLedgeSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (const ULevel* Level : InWorld.GetLevels())
+	{
+		if (Level && Level->bIsVisible)
+		{
+			LoadLevel(Level);
+		}
+	}
+}
+
+bool UALSLedgeSubsystem::IsCovered(const FVector& Location) const
+{
+	// A streamed level without a bake may add geometry on top of a baked one.
+	for (const TPair<FName, FBox>& Pair : UnbakedLevels)
+	{
+		if (Pair.Value.IsInsideOrOn(Location))
+		{
+			return false;
+		}
+	}
+
+	for (const TPair<FName, FLevelLedges>& Pair : Levels)
+	{
+		if (Pair.Value.Database.Bounds.IsInsideOrOn(Location))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UALSLedgeSubsystem::FindLedgeInReach(const FVector& Start, const FVector& Direction, const float Distance,
+                                          const float Radius, const float MinZ, const float MaxZ,
+                                          FALSLedgeHit* OutHit) const
+{
+	const FVector2D Direction2D = FVector2D(Direction).GetSafeNormal();
+	const FVector End = Start + FVector(Direction2D, 0.0f) * Distance;
+
+	for (const TPair<FName, FLevelLedges>& Pair : Levels)
+	{
+		const FALSLedgeDatabase& Database = Pair.Value.Database;
+
+		// Ledges are sampled along edges, so widen the sweep by half the spacing to never fall between two samples.
+		const float Width = Radius + Database.Spacing * 0.5f;
+
+		FBox Box(Start.ComponentMin(End) - FVector(Width), Start.ComponentMax(End) + FVector(Width));
+		Box.Min.Z = MinZ;
+		Box.Max.Z = MaxZ;
+		if (!Box.Intersect(Database.Bounds))
+		{
+			continue;
+		}
+
+		const FIntVector MinCell = Database.GetCell(Box.Min);
+		const FIntVector MaxCell = Database.GetCell(Box.Max);
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					const FIntPoint* Range = Database.Cells.Find(FIntVector(X, Y, Z));
+					if (!Range)
+					{
+						continue;
+					}
+
+					for (int32 i = Range->X; i < Range->X + Range->Y; ++i)
+					{
+						const FALSLedge& Ledge = Database.Ledges[i];
+						if (Ledge.Location.Z < MinZ || Ledge.Location.Z > MaxZ)
+						{
+							continue;
+						}
+
+						// Must face back at the sweep.
+						if ((FVector2D(Ledge.Normal.X, Ledge.Normal.Y) | Direction2D) > -0.5f)
+						{
+							continue;
+						}
+
+						const FVector2D ToLedge(Ledge.Location.X - Start.X, Ledge.Location.Y - Start.Y);
+						const float Along = ToLedge | Direction2D;
+						if (Along < -Width || Along > Distance + Width || FMath::Abs(ToLedge ^ Direction2D) > Width)
+						{
+							continue;
+						}
+
+						if (OutHit)
+						{
+							OutHit->Ledge = Ledge;
+							OutHit->Component = Pair.Value.Components.IsValidIndex(Ledge.Component)
+								                    ? Pair.Value.Components[Ledge.Component].Get()
+								                    : nullptr;
+						}
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+void UALSLedgeSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld() && World->HasBegunPlay())
+	{
+		LoadLevel(Level);
+	}
+}
+
+void UALSLedgeSubsystem::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// A null level means all levels were removed.
+	if (Level)
+	{
+		Levels.Remove(Level->GetOutermost()->GetFName());
+		UnbakedLevels.Remove(Level->GetOutermost()->GetFName());
+	}
+	else
+	{
+		Levels.Reset();
+		UnbakedLevels.Reset();
+	}
+}
+
+void UALSLedgeSubsystem::LoadLevel(const ULevel* Level)
+{
+	const UPackage* Package = Level->GetOutermost();
+	if (Levels.Contains(Package->GetFName()) || UnbakedLevels.Contains(Package->GetFName()))
+	{
+		return;
+	}
+
+	FLevelLedges LevelLedges;
+	if (!LevelLedges.Database.Load(FALSLedgeDatabase::GetFilePath(UWorld::RemovePIEPrefix(Package->GetName()))))
+	{
+		const FBox LevelBounds = ALevelBounds::CalculateLevelBounds(Level);
+		if (LevelBounds.IsValid)
+		{
+			UnbakedLevels.Add(Package->GetFName(), LevelBounds);
+		}
+		return;
+	}
+
+	LevelLedges.Components.Reserve(LevelLedges.Database.ComponentPaths.Num());
+	for (const FString& ComponentPath : LevelLedges.Database.ComponentPaths)
+	{
+		FSoftObjectPath Path(ComponentPath);
+#if WITH_EDITOR
+		if (GetWorld()->IsPlayInEditor())
+		{
+			Path.FixupForPIE(Package->GetPIEInstanceID());
+		}
+#endif
+		LevelLedges.Components.Add(Cast<UPrimitiveComponent>(Path.ResolveObject()));
+	}
+
+	Levels.Add(Package->GetFName(), MoveTemp(LevelLedges));
+}
@@ -0,0 +1,267 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Subsystems/ALSNetProfilerSubsystem.h"
+
+#include "Character/ALSBaseCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ALS::NetProfiler
+{
+	static constexpr float SampleInterval = 1.0f;
+
+	template <typename FuncType>
+	void ForEachProfiler(FuncType&& Func)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World && World->IsGameWorld())
+			{
+				if (UALSNetProfilerSubsystem* Profiler = World->GetSubsystem<UALSNetProfilerSubsystem>())
+				{
+					Func(*Profiler);
+				}
+			}
+		}
+	}
+
+	static const TCHAR* GetNetModeName(const ENetMode NetMode)
+	{
+		switch (NetMode)
+		{
+		case NM_Client: return TEXT("Client");
+		case NM_ListenServer: return TEXT("ListenServer");
+		case NM_DedicatedServer: return TEXT("DedicatedServer");
+		default: return TEXT("Standalone");
+		}
+	}
+
+	static FAutoConsoleCommand StartCommand(
+		TEXT("ALS.Net.Profile.Start"),
+		TEXT("Record ALS network stats of all game worlds to CSV. Optional argument: file name prefix"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const FString Name = Args.Num() > 0 ? Args[0] : TEXT("ALSNetProfile");
+			ForEachProfiler([&Name](UALSNetProfilerSubsystem& Profiler) { Profiler.StartRecording(Name); });
+		}));
+
+	static FAutoConsoleCommand StopCommand(
+		TEXT("ALS.Net.Profile.Stop"),
+		TEXT("Stop recording ALS network stats"),
+		FConsoleCommandDelegate::CreateLambda([]
+		{
+			ForEachProfiler([](UALSNetProfilerSubsystem& Profiler) { Profiler.StopRecording(); });
+		}));
+
+	static FAutoConsoleCommand SimulateCommand(
+		TEXT("ALS.Net.Simulate"),
+		TEXT("Simulate packet loss and latency on all game worlds. Arguments: <PacketLoss%> <LatencyMs>"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 PacketLoss = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0;
+			const int32 Latency = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+			ForEachProfiler([=](const UALSNetProfilerSubsystem& Profiler)
+			{
+				Profiler.SimulateNetworkConditions(PacketLoss, Latency);
+			});
+		}));
+}
+
+using namespace ALS::NetProfiler;
+
+void UALSNetProfilerSubsystem::Deinitialize()
+{
+	StopRecording();
+	Super::Deinitialize();
+}
+
+void UALSNetProfilerSubsystem::Tick(const float DeltaTime)
+{
+	BindNetDriver();
+
+	// Real time, so the samples are not affected by time dilation.
+	SampleTime += FApp::GetDeltaTime();
+	SampleGameThreadMs += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	SampleFrames++;
+
+	if (SampleTime >= SampleInterval)
+	{
+		WriteSample();
+
+		SampleTime = 0.0f;
+		SampleGameThreadMs = 0.0;
+		SampleFrames = 0;
+		RPCCounts.Reset();
+	}
+}
+
+ETickableTickType UALSNetProfilerSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+UWorld* UALSNetProfilerSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UALSNetProfilerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSNetProfilerSubsystem, STATGROUP_Tickables);
+}
+
+void UALSNetProfilerSubsystem::StartRecording(const FString& Name)
+{
+	const UWorld* World = GetWorld();
+	check(World);
+
+	const FString BaseName = FPaths::ProfilingDir() / TEXT("ALS") /
+		FString::Printf(TEXT("%s_%s_%s"), *Name, *World->GetName(), GetNetModeName(World->GetNetMode()));
+
+	StatsFilePath = BaseName + TEXT(".csv");
+	RPCFilePath = BaseName + TEXT("_RPCs.csv");
+
+	FFileHelper::SaveStringToFile(
+		TEXT("Time,Characters,InBytesPerSecond,OutBytesPerSecond,AverageOutBytesPerCharacter,FrameMs,GameThreadMs\n"),
+		*StatsFilePath);
+	FFileHelper::SaveStringToFile(TEXT("Time,Function,Count\n"), *RPCFilePath);
+
+	RecordingStartTime = World->GetRealTimeSeconds();
+	SampleTime = 0.0f;
+	SampleGameThreadMs = 0.0;
+	SampleFrames = 0;
+	RPCCounts.Reset();
+	NumSamples = 0;
+	LastSample = FALSNetSample();
+	bRecording = true;
+
+	BindNetDriver();
+}
+
+void UALSNetProfilerSubsystem::StopRecording()
+{
+	UnbindNetDriver();
+
+	bRecording = false;
+	RPCCounts.Reset();
+}
+
+void UALSNetProfilerSubsystem::BindNetDriver()
+{
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == BoundNetDriver.Get())
+	{
+		return;
+	}
+
+	UnbindNetDriver();
+
+	// The hook takes a single listener, don't take it from someone else.
+	if (NetDriver && !NetDriver->SendRPCDel.IsBound())
+	{
+		NetDriver->SendRPCDel.BindUObject(this, &UALSNetProfilerSubsystem::OnSendRPC);
+		BoundNetDriver = NetDriver;
+	}
+}
+
+void UALSNetProfilerSubsystem::UnbindNetDriver()
+{
+	if (UNetDriver* NetDriver = BoundNetDriver.Get())
+	{
+		NetDriver->SendRPCDel.Unbind();
+	}
+	BoundNetDriver.Reset();
+}
+
+// ReSharper disable once CppMemberFunctionMayBeConst
+void UALSNetProfilerSubsystem::OnSendRPC(AActor* Actor, UFunction* Function, void* Parameters,
+                                         FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject,
+                                         bool& bBlockSendRPC)
+{
+	// Includes RPCs of components such as UALSMantleComponent, which are sent through their owner.
+	if (bRecording && Function && Cast<AALSBaseCharacter>(Actor))
+	{
+		RPCCounts.FindOrAdd(Function->GetFName())++;
+	}
+}
+
+void UALSNetProfilerSubsystem::SimulateNetworkConditions(const int32 PacketLossPercentage, const int32 LatencyMs) const
+{
+#if DO_ENABLE_NET_TEST
+	if (UNetDriver* NetDriver = GetWorld()->GetNetDriver())
+	{
+		FPacketSimulationSettings Settings = NetDriver->PacketSimulationSettings;
+		Settings.PktLoss = FMath::Clamp(PacketLossPercentage, 0, 100);
+		Settings.PktLagMin = FMath::Max(LatencyMs, 0);
+		Settings.PktLagMax = Settings.PktLagMin;
+		NetDriver->SetPacketSimulationSettings(Settings);
+	}
+#endif
+}
+
+void UALSNetProfilerSubsystem::WriteSample()
+{
+	const UWorld* World = GetWorld();
+	check(World);
+
+	FALSNetSample Sample;
+	for (TActorIterator<AALSBaseCharacter> It(World); It; ++It)
+	{
+		Sample.NumCharacters++;
+	}
+
+	if (const UNetDriver* NetDriver = World->GetNetDriver())
+	{
+		if (const UNetConnection* ServerConnection = NetDriver->ServerConnection)
+		{
+			Sample.InBytesPerSecond += ServerConnection->InBytesPerSecond;
+			Sample.OutBytesPerSecond += ServerConnection->OutBytesPerSecond;
+		}
+
+		for (const UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			Sample.InBytesPerSecond += Connection->InBytesPerSecond;
+			Sample.OutBytesPerSecond += Connection->OutBytesPerSecond;
+		}
+	}
+
+	// The engine does not count bytes per actor, so this is an average over the characters.
+	if (Sample.NumCharacters > 0)
+	{
+		Sample.AverageOutBytesPerCharacter = static_cast<double>(Sample.OutBytesPerSecond) / Sample.NumCharacters;
+	}
+
+	const int32 Frames = FMath::Max(SampleFrames, 1);
+	Sample.FrameMs = SampleTime * 1000.0f / Frames;
+	Sample.GameThreadMs = SampleGameThreadMs / Frames;
+
+	LastSample = Sample;
+	NumSamples++;
+
+	const double Time = World->GetRealTimeSeconds() - RecordingStartTime;
+
+	const FString StatsRow = FString::Printf(TEXT("%.2f,%d,%lld,%lld,%.1f,%.3f,%.3f\n"),
+	                                         Time, Sample.NumCharacters, Sample.InBytesPerSecond,
+	                                         Sample.OutBytesPerSecond, Sample.AverageOutBytesPerCharacter,
+	                                         Sample.FrameMs, Sample.GameThreadMs);
+	FFileHelper::SaveStringToFile(StatsRow, *StatsFilePath, FFileHelper::EEncodingOptions::AutoDetect,
+	                              &IFileManager::Get(), FILEWRITE_Append);
+
+	if (RPCCounts.Num() > 0)
+	{
+		FString RPCRows;
+		for (const TPair<FName, int32>& Count : RPCCounts)
+		{
+			RPCRows += FString::Printf(TEXT("%.2f,%s,%d\n"), Time, *Count.Key.ToString(), Count.Value);
+		}
+		FFileHelper::SaveStringToFile(RPCRows, *RPCFilePath, FFileHelper::EEncodingOptions::AutoDetect,
+		                              &IFileManager::Get(), FILEWRITE_Append);
+	}
+}
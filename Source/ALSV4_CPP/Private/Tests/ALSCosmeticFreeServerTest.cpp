@@ -0,0 +1,161 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "AIController.h"
+#include "Character/ALSCharacter.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSCosmeticFreeServerTest, "ALS.Networking.CosmeticFreeServer",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace ALS::Tests
+{
+	static const TCHAR* CharacterClassPath =
+		TEXT("/ALSV4_CPP/AdvancedLocomotionV4/Blueprints/CharacterLogic/ALS_CharacterBP.ALS_CharacterBP_C");
+
+	static constexpr float StepTime = 1.0f / 30.0f;
+
+	// Input held for a number of steps.
+	struct FInputPhase
+	{
+		const TCHAR* Name;
+		int32 Steps;
+		FVector Input;
+		bool bSprint;
+		bool bJump;
+
+		// Keep aiming along +X in the looking direction mode, so sideways input strafes.
+		bool bStrafe;
+	};
+
+	static AALSBaseCharacter* SpawnServerCharacter(UWorld* World, UClass* CharacterClass, const FVector& Location,
+	                                               const bool bCosmeticFree)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		AALSBaseCharacter* Character = World->SpawnActor<AALSBaseCharacter>(CharacterClass, Location,
+		                                                                    FRotator::ZeroRotator, SpawnParams);
+		World->SpawnActor<AAIController>(SpawnParams)->Possess(Character);
+
+		// Match a networked dedicated server, where the pose is ticked although nothing is rendered.
+		Character->SetEnableNetworkOptimizations(true);
+		Character->SetCosmeticFreeServer(bCosmeticFree);
+		Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+		return Character;
+	}
+
+	static void ApplyInput(AALSBaseCharacter* Character, const FInputPhase& Phase, const bool bPhaseStart)
+	{
+		if (bPhaseStart)
+		{
+			Character->SprintAction(Phase.bSprint);
+			Character->JumpAction(Phase.bJump);
+
+			AAIController* Controller = CastChecked<AAIController>(Character->GetController());
+			if (Phase.bStrafe)
+			{
+				Character->SetDesiredRotationMode(EALSRotationMode::LookingDirection);
+				Character->SetRotationMode(EALSRotationMode::LookingDirection);
+				Controller->SetFocalPoint(Character->GetActorLocation() + FVector::ForwardVector * 100000.0f);
+			}
+			else
+			{
+				Controller->ClearFocus(EAIFocusPriority::Gameplay);
+			}
+		}
+
+		if (!Phase.Input.IsZero())
+		{
+			Character->AddMovementInput(Phase.Input, 1.0f);
+		}
+	}
+}
+
+using namespace ALS::Tests;
+
+/**
+ * Runs the same input through a regular and a cosmetic free server character side by side, and checks that their
+ * authoritative movement never diverges. Uses the demo character when the plugin content is available, so the anim
+ * graph and its curves take part, and the native character otherwise.
+ */
+bool FALSCosmeticFreeServerTest::RunTest(const FString& Parameters)
+{
+	UClass* CharacterClass = LoadClass<AALSBaseCharacter>(nullptr, CharacterClassPath);
+	if (!CharacterClass)
+	{
+		AddInfo(TEXT("Demo character not found, testing the native character without an anim graph."));
+		CharacterClass = AALSCharacter::StaticClass();
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	AActor* Floor = World->SpawnActor<AActor>();
+	UBoxComponent* FloorBox = NewObject<UBoxComponent>(Floor);
+	FloorBox->SetBoxExtent(FVector(20000.0f, 20000.0f, 50.0f));
+	FloorBox->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Floor->SetRootComponent(FloorBox);
+	FloorBox->RegisterComponent();
+
+	// Far enough apart to never touch each other.
+	const FVector Separation(0.0f, 5000.0f, 0.0f);
+	const FVector SpawnLocation(0.0f, -2500.0f, 200.0f);
+
+	AALSBaseCharacter* Regular = SpawnServerCharacter(World, CharacterClass, SpawnLocation, false);
+	AALSBaseCharacter* CosmeticFree = SpawnServerCharacter(World, CharacterClass, SpawnLocation + Separation, true);
+
+	const FInputPhase Phases[] = {
+		{TEXT("Land"), 30, FVector::ZeroVector, false, false, false},
+		{TEXT("Run"), 60, FVector::ForwardVector, false, false, false},
+		{TEXT("Sprint"), 60, FVector::ForwardVector, true, false, false},
+		{TEXT("Turn"), 45, FVector::RightVector, false, false, false},
+		{TEXT("Jump"), 45, FVector::RightVector, false, true, false},
+		{TEXT("Pivot"), 30, -FVector::ForwardVector, false, false, false},
+		// Grounded rotation adds the YawOffset curve while strafing, which the rotation check below covers.
+		{TEXT("Strafe"), 60, (FVector::ForwardVector + FVector::RightVector).GetSafeNormal(), false, false, true},
+		{TEXT("Stop"), 60, FVector::ZeroVector, false, false, false},
+	};
+
+	for (const FInputPhase& Phase : Phases)
+	{
+		for (int32 Step = 0; Step < Phase.Steps; ++Step)
+		{
+			ApplyInput(Regular, Phase, Step == 0);
+			ApplyInput(CosmeticFree, Phase, Step == 0);
+
+			World->Tick(LEVELTICK_All, StepTime);
+			++GFrameCounter;
+		}
+
+		TestEqual(*FString::Printf(TEXT("%s: location"), Phase.Name),
+		          CosmeticFree->GetActorLocation() - Separation, Regular->GetActorLocation());
+		TestTrue(*FString::Printf(TEXT("%s: rotation"), Phase.Name),
+		         CosmeticFree->GetActorRotation().Equals(Regular->GetActorRotation()));
+		TestEqual(*FString::Printf(TEXT("%s: velocity"), Phase.Name),
+		          CosmeticFree->GetVelocity(), Regular->GetVelocity());
+		TestTrue(*FString::Printf(TEXT("%s: movement state"), Phase.Name),
+		         CosmeticFree->GetMovementState() == Regular->GetMovementState());
+		TestTrue(*FString::Printf(TEXT("%s: gait"), Phase.Name), CosmeticFree->GetGait() == Regular->GetGait());
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Components/ALSMantleComponent.h"
+
+#include "Components/BoxComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSMantleMovingPlatformTest, "ALS.Mantle.MovingPlatform",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FALSMantleMovingPlatformTest::RunTest(const FString& Parameters)
+{
+	const FVector PlatformLocation(100.0f, 200.0f, 50.0f);
+	const FVector PlatformOffset(30.0f, -40.0f, 25.0f);
+	const FTransform LedgeTransform(FRotator(0.0f, 90.0f, 0.0f), FVector(120.0f, 200.0f, 100.0f));
+
+	// Components are left unregistered, so they can be moved without a world, whatever their mobility.
+	UALSMantleComponent* MantleComponent = NewObject<UALSMantleComponent>();
+
+	UBoxComponent* Platform = NewObject<UBoxComponent>();
+	Platform->SetMobility(EComponentMobility::Movable);
+	Platform->SetWorldLocation(PlatformLocation);
+
+	MantleComponent->SetMantleLedge({LedgeTransform, Platform});
+	TestTrue(TEXT("Target starts at the ledge"), MantleComponent->GetMantleTarget().Equals(LedgeTransform));
+	TestFalse(TEXT("Unmoved platform does not update the target"), MantleComponent->UpdateMantleTarget());
+
+	Platform->SetWorldLocation(PlatformLocation + PlatformOffset);
+	TestTrue(TEXT("Moved platform updates the target"), MantleComponent->UpdateMantleTarget());
+	TestEqual(TEXT("Target follows the platform"), MantleComponent->GetMantleTarget().GetLocation(),
+	          LedgeTransform.GetLocation() + PlatformOffset);
+	TestTrue(TEXT("Target keeps its rotation"),
+	         MantleComponent->GetMantleTarget().GetRotation().Equals(LedgeTransform.GetRotation()));
+	TestFalse(TEXT("Target is not recomputed until the platform moves again"), MantleComponent->UpdateMantleTarget());
+
+	UBoxComponent* StaticLedge = NewObject<UBoxComponent>();
+	StaticLedge->SetMobility(EComponentMobility::Static);
+	StaticLedge->SetWorldLocation(PlatformLocation);
+
+	MantleComponent->SetMantleLedge({LedgeTransform, StaticLedge});
+	StaticLedge->SetWorldLocation(PlatformLocation + PlatformOffset);
+	TestFalse(TEXT("Static ledge never updates the target"), MantleComponent->UpdateMantleTarget());
+	TestTrue(TEXT("Target stays at the static ledge"), MantleComponent->GetMantleTarget().Equals(LedgeTransform));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,206 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Subsystems/ALSNetProfilerSubsystem.h"
+
+#include "Character/ALSBaseCharacter.h"
+#include "EngineUtils.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Editor.h"
+#include "Settings/LevelEditorPlaySettings.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSNetBandwidthTest, "ALS.Networking.BandwidthBudget",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace ALS::Tests
+{
+	static const TCHAR* DemoMap = TEXT("/ALSV4_CPP/AdvancedLocomotionV4/Levels/ALS_DemoLevel");
+
+	// Listen server player and two clients.
+	static constexpr int32 NumPlayers = 3;
+
+	static constexpr float SettleSeconds = 5.0f;
+
+	static constexpr float RecordSeconds = 10.0f;
+
+	// Budgets of the listen server, in bytes per second, under the simulated loss and latency.
+	static constexpr double MaxAverageOutBytesPerCharacter = 4096.0;
+
+	static constexpr int64 MaxOutBytesPerSecond = 16384;
+
+	// The input script repeats every ScriptSteps steps of ScriptStepSeconds.
+	static constexpr float ScriptStepSeconds = 0.5f;
+
+	static constexpr int32 ScriptSteps = 8;
+
+	static UWorld* FindServerWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (World && Context.WorldType == EWorldType::PIE && World->GetNetMode() == NM_ListenServer)
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+
+	// Runs in circles, sprints, crouches, stands up again and rolls, so every replicated ALS feature sends traffic.
+	static void DrivePlayer(AALSBaseCharacter* Character, const double Time, const int32 Step, const bool bNewStep)
+	{
+		Character->AddMovementInput(FVector(FMath::Cos(Time), FMath::Sin(Time), 0.0f), 1.0f);
+
+		if (!bNewStep)
+		{
+			return;
+		}
+
+		switch (Step % ScriptSteps)
+		{
+		case 0:
+			Character->SetDesiredGait(EALSGait::Running);
+			break;
+		case 2:
+			Character->SetDesiredGait(EALSGait::Sprinting);
+			break;
+		case 4:
+			Character->SetDesiredGait(EALSGait::Running);
+			Character->StanceAction();
+			break;
+		case 6:
+			Character->StanceAction();
+			break;
+		case 7:
+			// Double tap.
+			Character->StanceAction();
+			Character->StanceAction();
+			break;
+		default: ;
+		}
+	}
+}
+
+using namespace ALS::Tests;
+
+DEFINE_LATENT_AUTOMATION_COMMAND(FALSStartNetPIECommand);
+
+bool FALSStartNetPIECommand::Update()
+{
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(PIE_ListenServer);
+	PlaySettings->SetPlayNumberOfClients(NumPlayers);
+	PlaySettings->SetRunUnderOneProcess(true);
+
+	FRequestPlaySessionParams Params;
+	Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+	Params.EditorPlaySettings = PlaySettings;
+	GEditor->RequestPlaySession(Params);
+
+	return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FALSConsoleCommand, FString, Command);
+
+bool FALSConsoleCommand::Update()
+{
+	GEngine->Exec(FindServerWorld(), *Command);
+	return true;
+}
+
+/** Drives the player characters of every PIE world with the input script for Duration seconds. */
+class FALSDrivePlayersCommand : public IAutomationLatentCommand
+{
+public:
+	explicit FALSDrivePlayersCommand(const float InDuration)
+		: Duration(InDuration)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		const double Time = GetCurrentRunTime();
+		const int32 Step = FMath::FloorToInt(Time / ScriptStepSeconds);
+		const bool bNewStep = Step != LastStep;
+		LastStep = Step;
+
+		// Each machine drives its own player, so the input reaches the server the way real input would.
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (!World || Context.WorldType != EWorldType::PIE)
+			{
+				continue;
+			}
+
+			for (TActorIterator<AALSBaseCharacter> It(World); It; ++It)
+			{
+				if (It->IsPlayerControlled() && It->IsLocallyControlled())
+				{
+					DrivePlayer(*It, Time, Step, bNewStep);
+				}
+			}
+		}
+
+		return Time >= Duration;
+	}
+
+private:
+	float Duration;
+
+	int32 LastStep = INDEX_NONE;
+};
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FALSCheckNetBudgetCommand, FAutomationTestBase*, Test);
+
+bool FALSCheckNetBudgetCommand::Update()
+{
+	const UWorld* ServerWorld = FindServerWorld();
+	if (!Test->TestNotNull(TEXT("Listen server world"), ServerWorld))
+	{
+		return true;
+	}
+
+	const UALSNetProfilerSubsystem* Profiler = ServerWorld->GetSubsystem<UALSNetProfilerSubsystem>();
+	if (!Test->TestTrue(TEXT("Server recorded samples"), Profiler && Profiler->GetNumSamples() > 0))
+	{
+		return true;
+	}
+
+	const FALSNetSample& Sample = Profiler->GetLastSample();
+	Test->TestTrue(TEXT("Every player has a character"), Sample.NumCharacters >= NumPlayers);
+	Test->TestTrue(*FString::Printf(TEXT("Average out bytes per character %.1f within %.1f"),
+	                                Sample.AverageOutBytesPerCharacter, MaxAverageOutBytesPerCharacter),
+	               Sample.AverageOutBytesPerCharacter <= MaxAverageOutBytesPerCharacter);
+	Test->TestTrue(*FString::Printf(TEXT("Out bytes per second %lld within %lld"),
+	                                Sample.OutBytesPerSecond, MaxOutBytesPerSecond),
+	               Sample.OutBytesPerSecond <= MaxOutBytesPerSecond);
+
+	return true;
+}
+
+/**
+ * Plays the demo level as a listen server with two clients under simulated packet loss and latency, drives every
+ * player with scripted input, records the network stats of the server with UALSNetProfilerSubsystem and checks them
+ * against the bandwidth budgets.
+ */
+bool FALSNetBandwidthTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(DemoMap);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FALSStartNetPIECommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(SettleSeconds));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSConsoleCommand(TEXT("ALS.Net.Simulate 5 100")));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSConsoleCommand(TEXT("ALS.Net.Profile.Start ALSBandwidthTest")));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSDrivePlayersCommand(RecordSeconds));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSCheckNetBudgetCommand(this));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSConsoleCommand(TEXT("ALS.Net.Profile.Stop")));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+
+	return true;
+}
+
+#endif
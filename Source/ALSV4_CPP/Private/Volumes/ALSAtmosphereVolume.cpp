@@ -0,0 +1,37 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Volumes/ALSAtmosphereVolume.h"
+
+#include "Components/BrushComponent.h"
+#include "Subsystems/ALSAtmosphereSubsystem.h"
+
+AALSAtmosphereVolume::AALSAtmosphereVolume(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Needs a query body for EncompassesPoint, but shouldn't block or overlap anything.
+	GetBrushComponent()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	GetBrushComponent()->SetCollisionResponseToAllChannels(ECR_Ignore);
+	GetBrushComponent()->SetGenerateOverlapEvents(false);
+}
+
+void AALSAtmosphereVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CachedBounds = GetComponentsBoundingBox(true);
+
+	if (UALSAtmosphereSubsystem* Atmosphere = GetWorld()->GetSubsystem<UALSAtmosphereSubsystem>())
+	{
+		Atmosphere->RegisterVolume(this);
+	}
+}
+
+void AALSAtmosphereVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UALSAtmosphereSubsystem* Atmosphere = GetWorld()->GetSubsystem<UALSAtmosphereSubsystem>())
+	{
+		Atmosphere->UnregisterVolume(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,46 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Volumes/ALSFlightNavVolume.h"
+
+#include "Components/BrushComponent.h"
+#include "Subsystems/ALSFlightNavSubsystem.h"
+
+AALSFlightNavVolume::AALSFlightNavVolume(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	GetBrushComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetBrushComponent()->SetGenerateOverlapEvents(false);
+}
+
+void AALSFlightNavVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bBuildOnBeginPlay)
+	{
+		RebuildNavigation();
+	}
+}
+
+void AALSFlightNavVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UALSFlightNavSubsystem* FlightNav = GetWorld()->GetSubsystem<UALSFlightNavSubsystem>())
+	{
+		FlightNav->RemoveVolume(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AALSFlightNavVolume::RebuildNavigation()
+{
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	if (UALSFlightNavSubsystem* FlightNav = GetWorld()->GetSubsystem<UALSFlightNavSubsystem>())
+	{
+		FlightNav->RequestBuild(this);
+	}
+}
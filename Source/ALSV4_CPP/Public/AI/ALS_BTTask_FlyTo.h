@@ -0,0 +1,51 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "Subsystems/ALSFlightNavSubsystem.h"
+#include "ALS_BTTask_FlyTo.generated.h"
+
+struct FALSFlyToMemory
+{
+	FALSFlightNavQueryPtr Query;
+
+	TArray<FVector> Path;
+
+	int32 PathIndex = 0;
+};
+
+/** Flies the Owning Pawn to the location or actor in the specified Blackboard Key, along a path through a flight navigation volume. */
+UCLASS(Category=ALS, meta=(DisplayName = "Fly To"))
+class ALSV4_CPP_API UALS_BTTask_FlyTo : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UALS_BTTask_FlyTo();
+
+	/** Distance at which a path point counts as reached. */
+	UPROPERTY(Category = Navigation, EditAnywhere, meta=(ClampMin = 1))
+	float AcceptableRadius = 100.0f;
+
+	/** Nodes the path search may expand before giving up. */
+	UPROPERTY(Category = Navigation, EditAnywhere, meta=(ClampMin = 1))
+	int32 MaxIterations = 20000;
+
+	/** Makes ALS characters take off when they are not flying yet. */
+	UPROPERTY(Category = Navigation, EditAnywhere)
+	bool bStartFlying = true;
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	                            EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	                              EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	                           EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+};
@@ -0,0 +1,24 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "ALS_BTTask_GetRandomFlightLocation.generated.h"
+
+/** Picks a random location reachable through a flight navigation volume within the Max Distance from the Owning Pawn's current location and assigns it to the specified Blackboard Key. */
+UCLASS(Category=ALS, meta=(DisplayName = "Get Random Flight Location"))
+class ALSV4_CPP_API UALS_BTTask_GetRandomFlightLocation : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UALS_BTTask_GetRandomFlightLocation();
+
+	/** Maximum distance the random location picked may be from pawn along each axis. */
+	UPROPERTY(Category = Navigation, EditAnywhere, meta=(ClampMin = 1))
+	float MaxDistance = 2000.0f;
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual FString GetStaticDescription() const override;
+};
@@ -75,9 +75,6 @@ namespace ALS
 
 	namespace MantleComponent
 	{
-		static const FName NAME_MantleEnd(TEXT("MantleEnd"));
-		static const FName NAME_MantleUpdate(TEXT("MantleUpdate"));
-		static const FName NAME_MantleTimeline(TEXT("MantleTimeline"));
 		static const FName NAME_IgnoreOnlyPawn(TEXT("IgnoreOnlyPawn"));
 	}
 }
\ No newline at end of file
@@ -42,6 +42,34 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Flight")
 	float TroposphereHeight = 1000000.f;
 
+	/**
+	 * Altitude over which air density drops to about a third, used to bake the density table of
+	 * UALSAtmosphereSubsystem. The density reaches zero at TroposphereHeight regardless.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Flight", meta = (ClampMin = 1))
+	float AtmosphereScaleHeight = 850000.f;
+
+	/**
+	 * Size of the cells that UALSAltitudeSubsystem caches ground heights for. Larger cells need fewer sweeps, but
+	 * report altitudes more conservatively over uneven ground.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Flight", meta = (ClampMin = 100))
+	float AltitudeGridCellSize = 2000.f;
+
+	/**
+	 * On dedicated servers, skip all purely cosmetic evaluation of ALS characters: foot IK, land prediction, layering,
+	 * air lean, dynamic transitions, the camera behavior mesh and the debug component. Root motion montages, the grounded
+	 * movement and yaw offset values, gameplay curves such as RotationAmount and YawOffset and the ragdoll pelvis
+	 * location keep updating.
+	 * Only the native anim update is trimmed; the anim graph of the character still evaluates every frame, so the
+	 * curves that drive gameplay stay the same as on a regular server.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = "Networking")
+	bool bCosmeticFreeDedicatedServer = false;
+
+	/** Is World a dedicated server that runs with bCosmeticFreeDedicatedServer. */
+	static bool IsCosmeticFreeServer(const UWorld* World);
+
 	static FORCEINLINE UALS_Settings* Get()
 	{
 		UALS_Settings* Settings = GetMutableDefault<UALS_Settings>();
@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "Components/TimelineComponent.h"
 #include "Data/ALSMovementSettingsPreset.h"
+#include "Data/ALSNetAssetRegistry.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
 #include "Engine/DataTable.h"
@@ -21,6 +22,8 @@ class UAnimMontage;
 class UALSPlayerCameraBehavior;
 enum class EVisibilityBasedAnimTickOption : uint8;
 
+DECLARE_LOG_CATEGORY_EXTERN(LogAlsBaseCharacter, Log, All)
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FJumpPressedSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnJumpedSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRagdollStateChangedSignature, bool, bRagdollState);
@@ -51,9 +54,23 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget,
+	                             UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
 	// We are overriding this to implement custom handling for flight logic.
 	virtual void AddMovementInput(FVector WorldDirection, float ScaleValue, bool bForce = false) override;
 
+	/**
+	 * The following override what BeginPlay picked from the net mode and UALS_Settings::bCosmeticFreeDedicatedServer,
+	 * e.g. to run a character like on a networked server in a standalone world.
+	 */
+	void SetEnableNetworkOptimizations(const bool bEnable) { bEnableNetworkOptimizations = bEnable; }
+
+	/** Also applies to the anim instance of the mesh. */
+	void SetCosmeticFreeServer(bool bCosmeticFree);
+
+	bool IsCosmeticFreeServer() const { return bCosmeticFreeServer; }
+
 	/** Ragdoll System */
 
 	/** Implement on BP to get required get up animation according to character's state */
@@ -67,7 +84,16 @@ public:
 	virtual void RagdollEnd();
 
 	UFUNCTION(BlueprintCallable, Server, Unreliable, Category = "ALS|Ragdoll System")
-	void Server_SetMeshLocationDuringRagdoll(FVector MeshLocation);
+	void Server_SetMeshLocationDuringRagdoll(FVector_NetQuantize MeshLocation);
+
+	/** Replication */
+
+	/**
+	 * Replicates the character at the full rate for NetUpdatePolicy.BumpDuration. Call on state changes that remote
+	 * players should see quickly. Only has an effect on the authority.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Replication")
+	void BumpNetUpdateFrequency();
 
 	/** Character States */
 
@@ -128,12 +154,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void SetFlightState(EALSFlightState NewFlightState, bool bForce = false);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetFlightState(EALSFlightState NewFlightState, bool bForce);
-
 	UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
 	EALSFlightState GetFlightState() const { return FlightState; }
 
+	UFUNCTION(BlueprintCallable, Category = "ALS|Flight")
+	UALSFlightComponent* GetFlightComponent() const { return ALSFlightComponent; }
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void SetOverlayState(EALSOverlayState NewState, bool bForce = false);
 
@@ -154,22 +180,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void EventOnLanded();
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Character States")
-	void Multicast_OnLanded();
-
 	/** On Jumped*/
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void EventOnJumped();
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Character States")
-	void Multicast_OnJumped();
-
 	/** Rolling Montage Play Replication*/
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_PlayMontage(UAnimMontage* Montage, float PlayRate);
+	void Server_PlayMontage(uint8 MontageID, float PlayRate);
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Character States")
-	void Multicast_PlayMontage(UAnimMontage* Montage, float PlayRate);
+	/** Server_PlayMontage for montages that are not in NetAssetRegistry, sent as an object reference. */
+	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
+	void Server_PlayMontageObject(UAnimMontage* Montage, float PlayRate);
 
 	/** Ragdolling */
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
@@ -282,7 +303,11 @@ public:
 	void SetVisibleMesh(USkeletalMesh* NewVisibleMesh);
 
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Utility")
-	void Server_SetVisibleMesh(USkeletalMesh* NewSkeletalMesh);
+	void Server_SetVisibleMesh(uint8 MeshID);
+
+	/** Server_SetVisibleMesh for meshes that are not in NetAssetRegistry, sent as an object reference. */
+	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Utility")
+	void Server_SetVisibleMeshObject(USkeletalMesh* NewVisibleMesh);
 
 	/** Camera System */
 
@@ -384,6 +409,15 @@ protected:
 
 	void SetActorLocationDuringRagdoll(float DeltaTime);
 
+	/** Sends the owner's ragdoll location to the server, or to the clients when called on the authority. */
+	void SendRagdollLocation(float DeltaTime);
+
+	/** Applies a ragdoll location received from the owner, according to RagdollSyncMode. */
+	void ReceiveRagdollLocation(const FVector& Location);
+
+	/** World transform of a simulated ragdoll bone. */
+	FTransform GetRagdollBoneTransform(FName BoneName) const;
+
 	/** State Changes */
 
 	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
@@ -439,23 +473,46 @@ protected:
 	void ForceUpdateCharacterState();
 
 	/** Replication */
-	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_RotationMode(EALSRotationMode PrevRotMode);
+
+	/** Copies the current state values into ReplicatedState. Only has an effect on the authority. */
+	void UpdateReplicatedState();
 
 	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_FlightState(EALSFlightState PrevFlightState);
+	void OnRep_ReplicatedState();
+
+	/**
+	 * Stores the montage in ReplicatedMontage so that simulated proxies play it, as MontageID when it is valid and as
+	 * an object reference otherwise. Only called on the authority.
+	 */
+	void SetReplicatedMontage(uint8 MontageID, UAnimMontage* Montage, float PlayRate);
+
+	/** Same as SetReplicatedMontage for the visible mesh. */
+	void SetReplicatedVisibleMesh(uint8 MeshID, USkeletalMesh* Mesh);
+
+	/**
+	 * Net IDs of assets in NetAssetRegistry, InvalidID when the asset is missing. Such assets are sent as object
+	 * references instead, which costs more bandwidth.
+	 */
+	uint8 GetMontageNetID(const UAnimMontage* Montage) const;
+
+	uint8 GetMeshNetID(const USkeletalMesh* Mesh) const;
 
 	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_ViewMode(EALSViewMode PrevViewMode);
+	void OnRep_ReplicatedMontage();
+
+	float GetServerWorldTimeSeconds() const;
+
+	/** Picks NetUpdateFrequency from NetUpdatePolicy. Runs on a timer on the authority. */
+	void UpdateNetUpdateFrequency();
 
 	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "OnViewModeChanged", ScriptName = "OnViewModeChanged"))
 	void K2_OnViewModeChanged(EALSViewMode PreviousViewMode);
 
 	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_OverlayState(EALSOverlayState PrevOverlayState);
+	void OnRep_VisibleMesh();
 
 	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_VisibleMesh(USkeletalMesh* NewVisibleMesh);
+	void OnRep_ReplicatedRagdollLocation();
 
 public:
 	/** Multicast delegate for ViewMode changing. */
@@ -469,13 +526,13 @@ protected:
 
 	/** Input */
 
-	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
 
-	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSGait DesiredGait = EALSGait::Running;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSStance DesiredStance = EALSStance::Standing;
 
 	UPROPERTY(EditDefaultsOnly, Category = "ALS|Input", BlueprintReadOnly)
@@ -542,12 +599,51 @@ protected:
 	FRotator ReplicatedControlRotation = FRotator::ZeroRotator;
 
 	/** Replicated Skeletal Mesh Information*/
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Skeletal Mesh", ReplicatedUsing = OnRep_VisibleMesh)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Skeletal Mesh")
 	TObjectPtr<USkeletalMesh> VisibleMesh = nullptr;
 
+	/** VisibleMesh as an ID in NetAssetRegistry, InvalidID while it is not registered */
+	UPROPERTY(ReplicatedUsing = OnRep_VisibleMesh)
+	uint8 VisibleMeshID = UALSNetAssetRegistry::InvalidID;
+
+	/** VisibleMesh while it is not registered in NetAssetRegistry, null otherwise */
+	UPROPERTY(ReplicatedUsing = OnRep_VisibleMesh)
+	TObjectPtr<USkeletalMesh> UnregisteredVisibleMesh = nullptr;
+
+	/**
+	 * Montages and meshes that this character sends over the network as a single byte. Unlisted assets are sent as
+	 * object references instead.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Replication")
+	TObjectPtr<UALSNetAssetRegistry> NetAssetRegistry;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Replication", ReplicatedUsing = OnRep_ReplicatedMontage)
+	FALSReplicatedMontage ReplicatedMontage;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Replication")
+	FALSNetUpdatePolicy NetUpdatePolicy;
+
+	FTimerHandle NetUpdatePolicyTimer;
+
+	/** World time until which BumpNetUpdateFrequency keeps the full rate */
+	float NetUpdateBumpEndTime = 0.0f;
+
+	/** World time the character last moved, had movement input, turned its view or was in an action */
+	float LastNetActiveTime = 0.0f;
+
+	/** Control rotation at the last evaluation of NetUpdatePolicy */
+	FRotator LastNetControlRotation = FRotator::ZeroRotator;
+
+	/** MinNetUpdateFrequency of the class, lowered along with NetUpdateFrequency */
+	float DefaultMinNetUpdateFrequency = 0.0f;
+
+	/** Replicated State Values, unpacked into the members below by OnRep_ReplicatedState */
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_ReplicatedState)
+	FALSReplicatedState ReplicatedState;
+
 	/** State Values */
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_OverlayState)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSOverlayState OverlayState = EALSOverlayState::Default;
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
@@ -562,7 +658,7 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSMovementAction MovementAction = EALSMovementAction::None;
 
-	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_RotationMode)
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
@@ -571,10 +667,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSStance Stance = EALSStance::Standing;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_ViewMode)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
 
-	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_FlightState)
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSFlightState FlightState = EALSFlightState::None;
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
@@ -638,9 +734,31 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Ragdoll System")
 	FVector LastRagdollVelocity = FVector::ZeroVector;
 
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Ragdoll System")
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Ragdoll System")
 	FVector TargetRagdollLocation = FVector::ZeroVector;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Ragdoll System")
+	EALSRagdollSyncMode RagdollSyncMode = EALSRagdollSyncMode::Interpolated;
+
+	/** Times per second the owner sends its ragdoll location */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Ragdoll System",
+		meta = (ClampMin = 1, EditCondition = "RagdollSyncMode == EALSRagdollSyncMode::Interpolated"))
+	float RagdollSyncRate = 15.0f;
+
+	/** How far remote ragdolls lag behind the newest received location, in send intervals */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Ragdoll System",
+		meta = (ClampMin = 0, EditCondition = "RagdollSyncMode == EALSRagdollSyncMode::Interpolated"))
+	float RagdollInterpolationDelay = 1.5f;
+
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedRagdollLocation)
+	FVector_NetQuantize ReplicatedRagdollLocation = FVector::ZeroVector;
+
+	/* Ragdoll locations received from the owner, used when RagdollSyncMode is Interpolated */
+	FALSRagdollSnapshotBuffer RagdollSnapshots;
+
+	/* Time since the owner last sent its ragdoll location */
+	float RagdollSyncTimeAccumulator = 0.0f;
+
 	/* Server ragdoll pull force storage*/
 	float ServerRagdollPull = 0.0f;
 
@@ -672,6 +790,9 @@ protected:
 	/** We won't use curve based movement and a few other features on networked games */
 	bool bEnableNetworkOptimizations = false;
 
+	/** Skip cosmetic only work, see UALS_Settings::bCosmeticFreeDedicatedServer */
+	bool bCosmeticFreeServer = false;
+
 private:
 	UPROPERTY()
 	TObjectPtr<UALSDebugComponent> ALSDebugComponent = nullptr;
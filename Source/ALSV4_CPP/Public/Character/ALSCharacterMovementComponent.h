@@ -31,10 +31,14 @@ public:
 		virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel,
 		                        class FNetworkPredictionData_Client_Character& ClientData) override;
 		virtual void PrepMoveFor(class ACharacter* Character) override;
+		virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
 
 		// Walk Speed Update
 		uint8 bSavedRequestMovementSettingsChange : 1;
 		EALSGait SavedAllowedGait = EALSGait::Walking;
+
+		// Flight
+		EALSFlightState SavedFlightState = EALSFlightState::None;
 	};
 
 	class ALSV4_CPP_API FNetworkPredictionData_Client_My : public FNetworkPredictionData_Client_Character
@@ -50,9 +54,13 @@ public:
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 	virtual void OnMovementUpdated(float DeltaTime, const FVector& OldLocation, const FVector& OldVelocity) override;
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
 
 	// Movement Settings Override
 	virtual void PhysWalking(float DeltaTime, int32 Iterations) override;
+	virtual void PhysFlying(float DeltaTime, int32 Iterations) override;
 	virtual float GetMaxAcceleration() const override;
 	virtual float GetMaxBrakingDeceleration() const override;
 
@@ -66,6 +74,11 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Movement System")
 	FALSMovementSettings CurrentMovementSettings;
 
+	// Flight state the current move is simulated with. Sent to the server with every move, so that starting and
+	// stopping flight is predicted and replayed like any other input.
+	UPROPERTY()
+	EALSFlightState RequestedFlightState = EALSFlightState::None;
+
 	// Set Movement Curve (Called in every instance)
 	float GetMappedSpeed() const;
 
@@ -78,4 +91,11 @@ public:
 
 	UFUNCTION(Reliable, Server, Category = "Movement Settings")
 	void Server_SetAllowedGait(EALSGait NewAllowedGait);
+
+protected:
+	// Starts flight once the owner has been falling for the flight component's catch delay.
+	void CatchFalling();
+
+	// Armed on the owning client when falling starts, in game time.
+	FTimerHandle CatchFallingTimer;
 };
@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "Camera/PlayerCameraManager.h"
+#include "Data/ALSCameraRigPreset.h"
 #include "ALSPlayerCameraManager.generated.h"
 
 // forward declarations
@@ -23,12 +24,18 @@ class ALSV4_CPP_API AALSPlayerCameraManager : public APlayerCameraManager
 public:
 	AALSPlayerCameraManager();
 
+	virtual void BeginPlay() override;
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
 	void OnPossess(AALSBaseCharacter* NewCharacter);
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
 	float GetCameraBehaviorParam(FName CurveName) const;
 
+	/** All camera behavior values, from the camera rig preset if one is set, otherwise from the anim BP curves. */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
+	FALSCameraRigParams GetCameraBehaviorParams() const;
+
 	/** Implemented debug logic in BP */
 	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, Category = "ALS|Camera")
 	void DrawDebugTargets(FVector PivotTargetLocation);
@@ -43,9 +50,22 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
 	bool CustomCameraBehavior(float DeltaTime, FVector& Location, FRotator& Rotation, float& FOV);
 
+	/** Camera location pulled in towards TraceOrigin in front of anything blocking the view of the character. */
+	FVector SolveCameraCollision(float DeltaTime, const FVector& TraceOrigin, const FVector& CameraLocation,
+	                             float TraceRadius, ECollisionChannel TraceChannel);
+
+	// Whether the last probes still hold, so sweeping again would give the same pull in.
+	bool IsCameraCollisionCacheValid(const FVector& TraceOrigin, const FVector& CameraLocation, float TraceRadius,
+	                                 ECollisionChannel TraceChannel) const;
+
+	void ResetCameraCollision();
+
 	UFUNCTION(BlueprintImplementableEvent, Category = "ALS|Camera", meta = (DisplayName = "On Possess"))
 	void K2_OnPossess();
 
+	// Blends the camera rig towards the state matching the controlled character. Snapping skips the blend.
+	void UpdateCameraRig(float DeltaTime, bool bSnap = false);
+
 public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "ALS|Camera")
 	TObjectPtr<AALSBaseCharacter> ControlledCharacter = nullptr;
@@ -53,6 +73,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "ALS|Camera")
 	TObjectPtr<USkeletalMeshComponent> CameraBehavior = nullptr;
 
+	// Drives the camera natively when set. The camera behavior mesh is then never animated.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Camera")
+	TObjectPtr<UALSCameraRigPreset> CameraRigPreset = nullptr;
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
 	FVector RootLocation;
@@ -75,7 +99,69 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera")
 	FVector DebugViewOffset;
 
+	// Sideways offset of the two extra collision probes. 0 only sweeps the center.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera Collision", meta = (ClampMin = 0))
+	float CameraCollisionProbeOffset = 20.0f;
+
+	// Speed of pulling the camera in front of an obstacle only the side probes hit. Obstacles of the center probe
+	// always snap. 0 snaps.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera Collision", meta = (ClampMin = 0))
+	float CameraCollisionPullInSpeed = 30.0f;
+
+	// Speed of moving the camera back out once an obstacle clears. 0 snaps.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera Collision", meta = (ClampMin = 0))
+	float CameraCollisionReleaseSpeed = 6.0f;
+
+	// The probes are reused while the trace origin and camera move less than this and nothing hit has moved.
+	// 0 sweeps every frame.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera Collision", meta = (ClampMin = 0))
+	float CameraCollisionCacheTolerance = 1.0f;
+
+	// Longest time the probes are reused, to notice objects moving into them.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera Collision", meta = (ClampMin = 0))
+	float CameraCollisionCacheTime = 0.1f;
+
+	// Current blended values of the camera rig.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	FALSCameraRigParams CameraRigParams;
+
 private:
+	// Values the current blend started from.
+	FALSCameraRigParams CameraRigBlendStart;
+
+	// Camera rig state being blended to, INDEX_NONE for the preset's default.
+	int32 CameraRigState = INDEX_NONE;
+
+	bool bCameraRigRightShoulder = true;
+
+	bool bCameraRigDebugView = false;
+
+	float CameraRigBlendElapsed = 0.0f;
+
+	// Smoothed distance the camera is pulled in by collision.
+	float CameraCollisionPullIn = 0.0f;
+
+	// Distance the last probes want the camera pulled in by.
+	float CameraCollisionTargetPullIn = 0.0f;
+
+	// Distance the last center probe requires the camera pulled in by, applied without smoothing.
+	float CameraCollisionMinPullIn = 0.0f;
+
+	// Inputs and hits of the last probes.
+	FVector CameraCollisionOrigin = FVector::ZeroVector;
+
+	FVector CameraCollisionLocation = FVector::ZeroVector;
+
+	float CameraCollisionRadius = 0.0f;
+
+	TEnumAsByte<ECollisionChannel> CameraCollisionChannel = ECC_Camera;
+
+	float CameraCollisionTime = 0.0f;
+
+	TArray<TPair<TWeakObjectPtr<UPrimitiveComponent>, FTransform>> CameraCollisionHitComponents;
+
+	bool bCameraCollisionCached = false;
+
 	UPROPERTY()
 	TObjectPtr<UALSDebugComponent> ALSDebugComponent = nullptr;
 };
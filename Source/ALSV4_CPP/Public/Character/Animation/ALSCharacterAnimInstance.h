@@ -47,6 +47,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Event")
 	void OnPivot();
 
+	/** Overrides what NativeInitializeAnimation picked from UALS_Settings::bCosmeticFreeDedicatedServer. */
+	void SetCosmeticFree(const bool bNewCosmeticFree) { bCosmeticFree = bNewCosmeticFree; }
+
+	bool IsCosmeticFree() const { return bCosmeticFree; }
+
 protected:
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Grounded")
@@ -300,6 +305,9 @@ private:
 
 	bool bCanPlayDynamicTransition = true;
 
+	/** Skip cosmetic only updates, see UALS_Settings::bCosmeticFreeDedicatedServer */
+	bool bCosmeticFree = false;
+
 	UPROPERTY()
 	TObjectPtr<UALSDebugComponent> ALSDebugComponent = nullptr;
 };
\ No newline at end of file
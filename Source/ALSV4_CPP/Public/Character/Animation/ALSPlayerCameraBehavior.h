@@ -6,6 +6,7 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Data/ALSCameraRigPreset.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 
 #include "ALSPlayerCameraBehavior.generated.h"
@@ -22,8 +23,13 @@ class ALSV4_CPP_API UALSPlayerCameraBehavior : public UAnimInstance
 	GENERATED_BODY()
 
 public:
+	virtual void NativePostEvaluateAnimation() override;
+
 	void SetRotationMode(EALSRotationMode RotationMode);
 
+	/** Camera curves of the last evaluation, read by AALSPlayerCameraManager once per frame. */
+	const FALSCameraRigParams& GetCameraParams() const { return CameraParams; }
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Read Only Data|Character Information")
 	EALSMovementState MovementState;
 
@@ -56,4 +62,8 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Read Only Data|Character Information")
 	bool bDebugView = false;
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Read Only Data|Camera")
+	FALSCameraRigParams CameraParams;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "ALSLedgeBakeCommandlet.generated.h"
+
+struct FALSLedgeDatabase;
+
+/**
+ * Bakes the mantleable ledges of static level geometry into the files read by UALSLedgeSubsystem. Surfaces are found
+ * by tracing down columns on the mantle check channel, plus a sweep over each column for the tops of thin obstacles.
+ * A walkable surface at least MinHeight above whatever is next below it in a neighboring column is a ledge, however
+ * deep the drop. The bake errs towards too many ledges, since it only lets mantle checks be skipped.
+ *
+ * Usage: -run=ALSLedgeBake [-Maps=/Game/MapA+/Game/MapB] [-Spacing=25] [-MinHeight=40] [-CellSize=200]
+ * Spacing must not be larger than the smallest ForwardTraceRadius of the mantle trace settings. Without -Maps, every
+ * map in the project's content directory is baked. Rebake after changing level geometry.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSLedgeBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UALSLedgeBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	bool BakeLevel(const FString& PackageName) const;
+
+	void BakeWorld(UWorld* World, FALSLedgeDatabase& OutDatabase) const;
+
+	float Spacing = 25.0f;
+
+	float MinLedgeHeight = 40.0f;
+
+	float CellSize = 200.0f;
+
+	// Same as the default of UCharacterMovementComponent.
+	float WalkableFloorZ = 0.71f;
+};
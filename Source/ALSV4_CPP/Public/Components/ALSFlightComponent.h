@@ -5,8 +5,65 @@
 #include "CoreMinimal.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Components/ActorComponent.h"
+#include "Subsystems/ALSAtmosphereSubsystem.h"
 #include "ALSFlightComponent.generated.h"
 
+/** Per flyer inputs of the aerodynamic model. */
+struct FALSAeroInputs
+{
+	// Lift in gravities at zero speed, e.g. from beating wings.
+	float BaseLift = 0.0f;
+
+	// Lift in gravities added at full speed, growing with the square of the speed.
+	float SpeedLift = 0.0f;
+
+	// Speed relative to the speed at which SpeedLift is reached.
+	float NormalizedSpeed = 0.0f;
+
+	float Speed = 0.0f;
+
+	// Air density relative to sea level.
+	float Density = 1.0f;
+
+	float TemperatureCelsius = 15.0f;
+
+	// Weight relative to the weight the lift values are tuned for.
+	float WeightRatio = 1.0f;
+
+	// 0 away from the ground, 1 touching it.
+	float GroundProximity = 0.0f;
+
+	// Extra lift at full ground proximity, as a fraction of the lift.
+	float GroundEffect = 0.0f;
+
+	float DragCoefficient = 0.0f;
+
+	float MaxLiftRatio = 1.0f;
+};
+
+namespace ALS::Aero
+{
+	/** Fraction of gravity carried by lift. */
+	FORCEINLINE float SolveLiftRatio(const float BaseLift, const float SpeedLift, const float NormalizedSpeed,
+	                                 const float Density, const float TemperatureCelsius, const float WeightRatio,
+	                                 const float GroundProximity, const float GroundEffect, const float MaxLiftRatio)
+	{
+		// Warmer air is thinner, relative to the 15 degree standard atmosphere.
+		const float Rho = Density * 288.15f / FMath::Max(TemperatureCelsius + 273.15f, 1.0f);
+		const float SpeedAlpha = FMath::Min(NormalizedSpeed * NormalizedSpeed, 1.0f);
+		const float Lift = Rho * (BaseLift + SpeedLift * SpeedAlpha) * (1.0f + GroundEffect * GroundProximity) /
+			FMath::Max(WeightRatio, KINDA_SMALL_NUMBER);
+		return FMath::Clamp(Lift, 0.0f, MaxLiftRatio);
+	}
+
+	/** Deceleration by air drag, in cm/s^2. */
+	FORCEINLINE float SolveDragDeceleration(const float Speed, const float Density, const float TemperatureCelsius,
+	                                        const float WeightRatio, const float DragCoefficient)
+	{
+		const float Rho = Density * 288.15f / FMath::Max(TemperatureCelsius + 273.15f, 1.0f);
+		return Rho * DragCoefficient * Speed * Speed / FMath::Max(WeightRatio, KINDA_SMALL_NUMBER);
+	}
+}
 
 UCLASS(Blueprintable, BlueprintType)
 class ALSV4_CPP_API UALSFlightComponent : public UActorComponent
@@ -16,31 +73,42 @@ class ALSV4_CPP_API UALSFlightComponent : public UActorComponent
 public:
 	UALSFlightComponent();
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
 	virtual void BeginPlay() override;
 
 public:
 
-	// @TODO flight catching should really be in the movement state machine not in the flight component.
-	UFUNCTION()
-	void OnOwningMovementModeChanged(class ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode);
-
 	UFUNCTION()
 	void OnActorHit(AActor* SelfActor, AActor* OtherActor, FVector NormalImpulse, const FHitResult& Hit);
 
 	// Essentially, this is this component's tick function, except it's only called when needed by its owning actor.
 	void UpdateFlight(float DeltaTime);
 
+	void UpdateRelativeAltitude();
+
 	void UpdateFlightRotation(float DeltaTime);
 
 	float CalculateFlightRotationRate() const;
 
-	void UpdateFlightMovement(float DeltaTime);
+	/**
+	 * Lift ratio, drag deceleration and updraft acceleration of a move starting at Location with Velocity. Solved from
+	 * the move, the world and replicated settings only, so the server and replayed moves get what the original move got.
+	 */
+	void CalculateMoveAero(EALSFlightState State, const FVector& Location, const FVector& Velocity,
+	                       float& OutLiftRatio, float& OutDragDeceleration, float& OutUpdraftAcceleration) const;
+
+	/** World space altitude above which flight can't climb any further. */
+	float GetMaxAltitude() const;
 
 	UFUNCTION(BlueprintNativeEvent, BlueprintPure = false, Category = "ALS|Flight")
 	bool FlightInterruptCheck(AActor* Other, FVector NormalImpulse, const FHitResult& Hit) const;
 
-	/** This can be overriden to setup custom conditions for allowing character flight. */
+	/**
+	 * This can be overriden to setup custom conditions for allowing character flight. Also false inside no-fly zones.
+	 * SetFlightState asks this on the server too, so the conditions are authoritative.
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "ALS|Flight")
 	virtual bool CanFly() const;
 
@@ -48,17 +116,41 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintPure = false, Category = "ALS|Flight")
 	bool FlightCheck() const;
 
-	// @TODO flight catching should really be in the movement state machine not in the flight component.
+	// Asked once the owner has been falling for TimeToWaitBeforeCatchFalling, to decide whether to start flying.
 	UFUNCTION(BlueprintNativeEvent, Category = "ALS|Flight")
 	bool WantsToCatchFalling() const;
 
+	float GetTimeToWaitBeforeCatchFalling() const { return TimeToWaitBeforeCatchFalling; }
+
 	// Gets the relative altitude of the player, measuring down to a point below the character.
 	UFUNCTION(BlueprintCallable, Category = "ALS|Flight")
 	float FlightDistanceCheck(float CheckDistance, FVector Direction) const;
 
 	void AdjustFlightInput(FVector& WorldDirection, float& ScaleValue);
 
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "ALS|Flight|Aerodynamics")
+	void SetWeightRatio(float NewWeightRatio);
+
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "ALS|Flight|Aerodynamics")
+	void SetTemperature(float NewTemperature);
+
+	float GetWeightRatio() const { return WeightRatio; }
+
+	float GetTemperature() const { return Temperature; }
+
 protected:
+	FALSAeroInputs MakeAeroInputsAt(EALSFlightState State, const FVector& Velocity, float Density,
+	                                float InGroundProximity) const;
+
+	// Closeness of the ground effect fan cast from Bottom to any surface. 0 is out of range, 1 touching. Keeps no
+	// state between calls, so replayed moves sample what the original move sampled.
+	float SampleGroundProximity(const FVector& Bottom, const FVector& Velocity) const;
+
+	// Direction the wings push the air to. Tilts from straight down towards the back at speed.
+	FVector GetDownwashDirection(const FVector& Velocity) const;
+
+	float TraceFlightDistance(const FVector& Start, float CheckDistance, const FVector& Direction) const;
+
 	// The velocity of the hit required to trigger a positive FlightInterruptThresholdCheck.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Flight")
 	float FlightInterruptThreshold = 600;
@@ -76,11 +168,55 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Flight", Meta = (UIMin = 0, UIMax = 90))
 	float MaxFlightForwardAngle = 85;
 
+	// Below this altitude, as estimated by UALSAltitudeSubsystem, the altitude is measured with a trace instead.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight", Meta = (ClampMin = 0))
+	float ExactAltitudeCheckDistance = 1000;
+
+	// Lift, in gravities, while hovering at sea level in standard conditions.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 0))
+	float HoverLiftRatio = 1.0f;
+
+	// Lift, in gravities, while gliding in the Aerial state without speed. Reaches 1 at max fly speed.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 0, ClampMax = 1))
+	float MinGlideLiftRatio = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 0))
+	float MaxLiftRatio = 1.5f;
+
+	// Extra lift right above the ground, as a fraction of the lift.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 0))
+	float GroundEffectStrength = 0.25f;
+
+	// Altitude below which the ground effect starts.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 1))
+	float GroundEffectHeight = 200.0f;
+
+	// Number of rays in the fan that samples the ground effect. The first one points along the downwash.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 1, ClampMax = 32))
+	int32 GroundEffectRayCount = 7;
+
+	// Angle between the downwash and the outer rays of the fan.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 0, ClampMax = 89))
+	float GroundEffectFanAngle = 50.0f;
+
+	// Drag deceleration per squared speed, in 1/cm.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 0))
+	float DragCoefficient = 0.0001f;
+
+	// Weight relative to the weight the lift values are tuned for, e.g. raised when carrying something heavy.
+	// Feeds movement, so it is only set by the server and replicated.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Replicated, Category = "ALS|Flight|Aerodynamics", Meta = (ClampMin = 0.01))
+	float WeightRatio = 1.0f;
+
+	// Air temperature around the character, in degrees Celsius. Set by the server and replicated like WeightRatio.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Replicated, Category = "ALS|Flight|Aerodynamics")
+	float Temperature = 15.0f;
+
 	// Maximum rotation in Yaw, Pitch and Roll, that may be achieved in flight.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight")
 	FVector MaxFlightLean = {40, 40, 0};
 
-	// @TODO flight catching should really be in the movement state machine not in the flight component.
+	// Game time spent falling before flight is started automatically. Negative values disable it.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Flight")
 	float TimeToWaitBeforeCatchFalling = 1;
 
@@ -91,16 +227,14 @@ private:
 	UPROPERTY()
 	TObjectPtr<UALSDebugComponent> ALSDebugComponent = nullptr;
 
-	// Altitude variables for flight calculations.
-	float SeaAltitude = 0; // @todo essentially global.
+	UPROPERTY()
+	TObjectPtr<class UALSAltitudeSubsystem> AltitudeSubsystem = nullptr;
 
-	float AtmosphereAtAltitude = 1;
+	UPROPERTY()
+	TObjectPtr<class UALSAtmosphereSubsystem> AtmosphereSubsystem = nullptr;
 
-	float TroposphereHeight = 0; // @todo essentially global.
+	// Atmosphere at the character's location, updated during flight.
+	FALSAtmosphereSample Atmosphere;
 
 	float RelativeAltitude = 0;
-
-	// @TODO flight catching should really be in the movement state machine not in the flight component.
-	// Used to track how long we have been falling for.
-	FDateTime TimeStartingFalling;
 };
\ No newline at end of file
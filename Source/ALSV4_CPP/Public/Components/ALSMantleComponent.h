@@ -8,11 +8,13 @@
 #include "Character/ALSBaseCharacter.h"
 #include "Components/ActorComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "WorldCollision.h"
 
 #include "ALSMantleComponent.generated.h"
 
 // forward declarations
 class UALSDebugComponent;
+class UALSLedgeSubsystem;
 
 UCLASS(Blueprintable, BlueprintType)
 class ALSV4_CPP_API UALSMantleComponent : public UActorComponent
@@ -26,6 +28,14 @@ public:
 	bool MantleCheck(const FALSMantleTraceSettings& TraceSettings,
 	                 EDrawDebugTrace::Type DebugType);
 
+	/**
+	 * Performs the traces of MantleCheck asynchronously, one per frame, and starts the mantle once all passed. The check
+	 * is dropped if the character's movement state or action changes, or it moves away, while traces are in flight.
+	 * Returns false if an async check is already running.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System")
+	bool MantleCheckAsync(const FALSMantleTraceSettings& TraceSettings);
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System")
 	void MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
 	                EALSMantleType MantleType);
@@ -50,6 +60,15 @@ public:
 	UFUNCTION(BlueprintNativeEvent)
 	bool CanMantle(EALSMantleType Type);
 
+	/** Stores the ledge in the space of its component and sets MantleTarget to it. */
+	void SetMantleLedge(const FALSComponentAndTransform& MantleLedgeWS);
+
+	/** Moves MantleTarget along with the ledge component. Returns true if the component moved since the last update. */
+	bool UpdateMantleTarget();
+
+	/** World space transform the current mantle ends at. */
+	const FTransform& GetMantleTarget() const { return MantleTarget; }
+
 protected:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
 	                           FActorComponentTickFunction* ThisTickFunction) override;
@@ -57,6 +76,18 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	/** Advances a playing mantle, calling MantleUpdate and finally MantleEnd. */
+	void TickMantle(float DeltaTime);
+
+	/** Mantle check from tick, skipped while nothing changed since the last one that found nothing. */
+	void AutomaticMantleCheck(const FALSMantleTraceSettings& TraceSettings);
+
+	void RecordFailedCheck(const FALSMantleTraceSettings& TraceSettings, const FVector& Location,
+	                       const FVector& Direction);
+
+	/** Can an automatic check with TraceSettings find anything, according to the baked ledges of the level. */
+	bool MayHaveLedgeInReach(const FALSMantleTraceSettings& TraceSettings) const;
+
 	/** Mantling*/
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Mantle System")
 	void Server_MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
@@ -67,9 +98,6 @@ protected:
 	                           EALSMantleType MantleType);
 
 protected:
-	UPROPERTY(BlueprintReadWrite, Category = "ALS|Mantle System")
-	TObjectPtr<UTimelineComponent> MantleTimeline = nullptr;
-
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	FALSMantleTraceSettings GroundedTraceSettings;
 
@@ -79,6 +107,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	FALSMantleTraceSettings FallingTraceSettings;
 
+	/** Blend in of the mantle over its playback time, passed to MantleUpdate. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	TObjectPtr<UCurveFloat> MantleTimelineCurve;
 
@@ -98,12 +127,28 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
 	FTransform MantleTarget = FTransform::Identity;
 
+	/** Transform of the ledge component MantleTarget was last updated for. */
+	FTransform MantleLedgeComponentTransform = FTransform::Identity;
+
+	/** Static ledges never move, so MantleTarget is set once on start. */
+	bool bMantleLedgeStatic = false;
+
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
 	FTransform MantleActualStartOffset = FTransform::Identity;
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
 	FTransform MantleAnimatedStartOffset = FTransform::Identity;
 
+	/** Time into the playing mantle, scaled by its play rate. */
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
+	float MantlePlaybackPosition = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
+	float MantlePlaybackLength = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
+	bool bMantlePlaying = false;
+
 	/** If a dynamic object has a velocity bigger than this value, do not start mantle */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	float AcceptableVelocityWhileMantling = 10.0f;
@@ -116,10 +161,116 @@ protected:
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Mantle System")
 	bool bAlwaysCatchIfFalling = true;
 
+	/**
+	 * Skip automatic vault checks where the baked ledges of the level have nothing in reach, and no movable object is
+	 * in reach either. Needs ledges baked with UALSLedgeBakeCommandlet. Checks from jump input and falling checks are
+	 * never skipped.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
+	bool bUseLedgeDatabase = false;
+
+	/** Perform automatic checks with MantleCheckAsync. Takes traces off the game thread, at a few frames of latency. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
+	bool bAsyncAutomaticChecks = true;
+
+	/**
+	 * Automatic checks after one that found nothing wait until the character moved this fraction of the settings'
+	 * ReachDistance, so a ledge that came into reach is still in reach when it is found...
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System", meta = (ClampMin = 0, ClampMax = 1))
+	float AutomaticCheckReachFraction = 0.25f;
+
+	/** ...or turned this far... */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System", meta = (ClampMin = 0, ClampMax = 180, Units = "deg"))
+	float AutomaticCheckAngleThreshold = 5.0f;
+
+	/** ...or this much time passed. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System", meta = (ClampMin = 0, Units = "s"))
+	float AutomaticCheckMaxInterval = 0.25f;
+
 private:
+	// State of a mantle check carried from one trace to the next.
+	struct FMantleCheckContext
+	{
+		FALSMantleTraceSettings TraceSettings;
+
+		// Settings member of this component, if started by an automatic check.
+		const FALSMantleTraceSettings* AutomaticSettings = nullptr;
+
+		EALSMovementState MovementState = EALSMovementState::None;
+
+		FVector ActorLocation = FVector::ZeroVector;
+
+		// Speed and world time when the check started, to judge how far the character may have moved since.
+		float Speed = 0.0f;
+
+		float StartTime = 0.0f;
+
+		FVector TraceDirection = FVector::ZeroVector;
+
+		FVector CapsuleBaseLocation = FVector::ZeroVector;
+
+		FVector InitialTraceImpactPoint = FVector::ZeroVector;
+
+		FVector InitialTraceNormal = FVector::ZeroVector;
+
+		TWeakObjectPtr<UPrimitiveComponent> HitComponent;
+
+		FVector CapsuleLocationFBase = FVector::ZeroVector;
+	};
+
+	FMantleCheckContext MakeMantleCheckContext(const FALSMantleTraceSettings& TraceSettings) const;
+
+	bool CheckForwardHit(FMantleCheckContext& Context, const FHitResult& HitResult) const;
+
+	bool CheckDownwardHit(FMantleCheckContext& Context, const FHitResult& HitResult) const;
+
+	void StartCheckedMantle(const FMantleCheckContext& Context);
+
+	void CancelAsyncMantleCheck();
+
+	// Whether Datum belongs to the running async check, and not to one that was cancelled or finished.
+	bool IsAsyncCheckCurrent(const FTraceDatum& Datum) const;
+
+	// Whether the results of the running async check still apply to the character.
+	bool IsAsyncCheckStillValid() const;
+
+	void OnAsyncForwardTrace(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	void OnAsyncDownwardTrace(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	void OnAsyncRoomTrace(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	void FinishAsyncMantleCheck(bool bSuccess);
+
 	UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess = true))
 	TObjectPtr<AALSBaseCharacter> OwnerCharacter;
 
 	UPROPERTY()
 	TObjectPtr<UALSDebugComponent> ALSDebugComponent = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UALSLedgeSubsystem> LedgeSubsystem = nullptr;
+
+	// Last automatic check that found nothing. Null settings when there is none.
+	const FALSMantleTraceSettings* LastFailedCheckSettings = nullptr;
+
+	FVector LastFailedCheckLocation = FVector::ZeroVector;
+
+	FVector LastFailedCheckDirection = FVector::ZeroVector;
+
+	float LastFailedCheckTime = 0.0f;
+
+	FMantleCheckContext AsyncCheck;
+
+	// Passed along with async traces, so results of canceled checks can be told apart.
+	uint32 AsyncCheckSerial = 0;
+
+	bool bAsyncCheckPending = false;
+
+	FTraceDelegate ForwardTraceDelegate;
+
+	FTraceDelegate DownwardTraceDelegate;
+
+	FTraceDelegate RoomTraceDelegate;
 };
\ No newline at end of file
@@ -0,0 +1,119 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSCameraRigPreset.generated.h"
+
+class UCurveFloat;
+
+/** Values AALSPlayerCameraManager drives the camera with. Names match the curves of the camera behavior anim BP. */
+USTRUCT(BlueprintType)
+struct ALSV4_CPP_API FALSCameraRigParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Rig")
+	float RotationLagSpeed = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Rig")
+	FVector PivotLagSpeed = FVector(15.0f, 15.0f, 15.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Rig")
+	FVector PivotOffset = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Rig")
+	FVector CameraOffset = FVector(-300.0f, 0.0f, 0.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Rig", meta = (ClampMin = 0, ClampMax = 1))
+	float Weight_FirstPerson = 0.0f;
+
+	// Set from the debug view toggle, not authored per state.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera Rig")
+	float Override_Debug = 0.0f;
+
+	/** Value of the camera behavior curve CurveName, or 0 for unknown names. */
+	float GetParam(FName CurveName) const;
+
+	static FALSCameraRigParams Lerp(const FALSCameraRigParams& A, const FALSCameraRigParams& B, float Alpha);
+};
+
+/** Camera parameters for the character states matching all of the masks. An empty mask matches any value. */
+USTRUCT(BlueprintType)
+struct ALSV4_CPP_API FALSCameraRigState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Camera Rig", meta = (Bitmask, BitmaskEnum = "EALSMovementState"))
+	int32 MovementStates = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Rig", meta = (Bitmask, BitmaskEnum = "EALSGait"))
+	int32 Gaits = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Rig", meta = (Bitmask, BitmaskEnum = "EALSStance"))
+	int32 Stances = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Rig", meta = (Bitmask, BitmaskEnum = "EALSRotationMode"))
+	int32 RotationModes = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Rig", meta = (Bitmask, BitmaskEnum = "EALSViewMode"))
+	int32 ViewModes = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Rig")
+	FALSCameraRigParams Params;
+
+	// Time to blend to this state. Negative uses the preset's default.
+	UPROPERTY(EditAnywhere, Category = "Camera Rig")
+	float BlendTime = -1.0f;
+
+	// Shapes the blend to this state. Uses the preset's default if not set.
+	UPROPERTY(EditAnywhere, Category = "Camera Rig")
+	TObjectPtr<UCurveFloat> BlendCurve = nullptr;
+
+	bool Matches(EALSMovementState MovementState, EALSGait Gait, EALSStance Stance, EALSRotationMode RotationMode,
+	             EALSViewMode ViewMode) const;
+};
+
+/**
+ * Native replacement for the camera behavior anim BP. AALSPlayerCameraManager picks the first state matching the
+ * character and blends to its parameters, without a hidden skeletal mesh or any animation evaluation.
+ */
+UCLASS(CollapseCategories)
+class ALSV4_CPP_API UALSCameraRigPreset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Index of the first state matching the character, or INDEX_NONE to use DefaultParams. */
+	int32 FindState(EALSMovementState MovementState, EALSGait Gait, EALSStance Stance, EALSRotationMode RotationMode,
+	                EALSViewMode ViewMode) const;
+
+	const FALSCameraRigParams& GetParams(int32 StateIndex) const;
+
+	float GetBlendTime(int32 StateIndex) const;
+
+	/** Shaped blend alpha for the linear progress Time of a blend to the state. */
+	float GetBlendAlpha(int32 StateIndex, float Time) const;
+
+	// Used when no state matches.
+	UPROPERTY(EditAnywhere, Category = "Camera Rig")
+	FALSCameraRigParams DefaultParams;
+
+	// Tested in order, the first match wins.
+	UPROPERTY(EditAnywhere, Category = "Camera Rig")
+	TArray<FALSCameraRigState> States;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Rig", meta = (ClampMin = 0))
+	float DefaultBlendTime = 0.5f;
+
+	// Smooth step is used if not set.
+	UPROPERTY(EditAnywhere, Category = "Camera Rig")
+	TObjectPtr<UCurveFloat> DefaultBlendCurve = nullptr;
+
+	// Negates the Y offsets while the camera is over the left shoulder, so states only need authoring for the right.
+	UPROPERTY(EditAnywhere, Category = "Camera Rig")
+	bool bMirrorLeftShoulder = true;
+};
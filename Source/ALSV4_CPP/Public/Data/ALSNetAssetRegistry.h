@@ -0,0 +1,39 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+
+#include "ALSNetAssetRegistry.generated.h"
+
+class UAnimMontage;
+class USkeletalMesh;
+
+/**
+ * Maps the montages and meshes a character can use to small IDs, so that ALS RPCs and replicated properties send a
+ * single byte instead of an object reference. Each list can hold at most 255 entries.
+ */
+UCLASS(CollapseCategories)
+class ALSV4_CPP_API UALSNetAssetRegistry : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr uint8 InvalidID = MAX_uint8;
+
+	uint8 GetMontageID(const UAnimMontage* Montage) const;
+
+	UAnimMontage* GetMontage(uint8 ID) const;
+
+	uint8 GetMeshID(const USkeletalMesh* Mesh) const;
+
+	USkeletalMesh* GetMesh(uint8 ID) const;
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "Net Assets")
+	TArray<TObjectPtr<UAnimMontage>> Montages;
+
+	UPROPERTY(EditAnywhere, Category = "Net Assets")
+	TArray<TObjectPtr<USkeletalMesh>> Meshes;
+};
@@ -179,4 +179,16 @@ enum class EALSSpawnType : uint8
 {
 	Location,
 	Attached
-};
\ No newline at end of file
+};
+
+/**
+ * How the ragdoll location of a character is synchronized over the network.
+ */
+UENUM(BlueprintType)
+enum class EALSRagdollSyncMode : uint8
+{
+	// The owner sends its location every frame, remote machines pull towards the latest value.
+	EveryFrame,
+	// The owner sends its location at a fixed rate, remote machines interpolate between buffered snapshots.
+	Interpolated
+};
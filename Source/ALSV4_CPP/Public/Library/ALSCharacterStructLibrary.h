@@ -23,6 +23,7 @@ class UNiagaraSystem;
 class UMaterialInterface;
 class USoundBase;
 class UPrimitiveComponent;
+class UCharacterMovementComponent;
 
 USTRUCT(BlueprintType)
 struct FALSComponentAndTransform
@@ -165,6 +166,84 @@ struct FALSMantleTraceSettings
 	float DownwardTraceRadius = 0.0f;
 };
 
+/** Pose to test a mantle from, see UALSMantleQueryLibrary. */
+USTRUCT(BlueprintType)
+struct FALSMantleQuery
+{
+	GENERATED_BODY()
+
+	/** Center of the character's capsule. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FVector Location = FVector::ZeroVector;
+
+	/** Facing of the character, only the horizontal part is used. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FVector Direction = FVector::ForwardVector;
+
+	/** Test as a falling catch instead of a grounded mantle. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	bool bFalling = false;
+};
+
+/** Character shape and traces a mantle query is run with, mirroring UALSMantleComponent. */
+USTRUCT(BlueprintType)
+struct FALSMantleQuerySettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FALSMantleTraceSettings TraceSettings;
+
+	/** Scaled radius of the character's capsule. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float CapsuleRadius = 30.0f;
+
+	/** Scaled half height of the character's capsule. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float CapsuleHalfHeight = 90.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FName MantleObjectDetectionProfile = TEXT("IgnoreOnlyPawn");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	TEnumAsByte<ECollisionChannel> WalkableSurfaceDetectionChannel = ECC_Visibility;
+
+	/**
+	 * Judges walkable surfaces with IsWalkable of this movement component, like a live check. Without one, surfaces
+	 * are walkable from WalkableFloorZ, with the walkable slope overrides of the hit components applied.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	TObjectPtr<UCharacterMovementComponent> MovementComponent = nullptr;
+
+	/** Minimum Z of a walkable surface normal, as in the character movement component. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float WalkableFloorZ = 0.71f;
+};
+
+USTRUCT(BlueprintType)
+struct FALSMantleQueryResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Mantle System")
+	bool bCanMantle = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Mantle System")
+	EALSMantleType MantleType = EALSMantleType::LowMantle;
+
+	/** Height of the mantle target over the query location. */
+	UPROPERTY(BlueprintReadOnly, Category = "Mantle System")
+	float MantleHeight = 0.0f;
+
+	/** Capsule center and facing at the end of the mantle. */
+	UPROPERTY(BlueprintReadOnly, Category = "Mantle System")
+	FTransform Target = FTransform::Identity;
+
+	/** Point on the walkable surface of the ledge. */
+	UPROPERTY(BlueprintReadOnly, Category = "Mantle System")
+	FVector LedgeLocation = FVector::ZeroVector;
+};
+
 USTRUCT(BlueprintType)
 struct FALSMovementSettings
 {
@@ -373,4 +452,249 @@ public:
 	{
 		return !Affect.IsNull();
 	}
-};
\ No newline at end of file
+};
+/**
+ * The montage action (roll, breakfall...) a character last started. Replicated as state instead of a multicast, so
+ * late joiners and characters becoming relevant again can pick the montage up where it currently is.
+ */
+USTRUCT(BlueprintType)
+struct FALSReplicatedMontage
+{
+	GENERATED_BODY()
+
+	/** ID of the montage in the character's UALSNetAssetRegistry. */
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated Montage")
+	uint8 MontageID = MAX_uint8;
+
+	/** Sent instead of MontageID for montages that are not in the registry. */
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated Montage")
+	TObjectPtr<UAnimMontage> Montage = nullptr;
+
+	/** Server world time at which the montage was started. */
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated Montage")
+	float StartServerTime = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated Montage")
+	float PlayRate = 1.0f;
+};
+
+/**
+ * Replicated character state, packed into a handful of bits. Sent to simulated proxies as a single property so
+ * that related changes (e.g. RotationMode and ViewMode) always arrive together.
+ * Note: Widen the bit counts below if entries are added to any of these enums.
+ */
+USTRUCT(BlueprintType)
+struct FALSReplicatedState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated State")
+	EALSGait DesiredGait = EALSGait::Running;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated State")
+	EALSStance DesiredStance = EALSStance::Standing;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated State")
+	EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated State")
+	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated State")
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated State")
+	EALSFlightState FlightState = EALSFlightState::None;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Replicated State")
+	EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+	{
+		SerializeEnumBits(Ar, DesiredGait, 2);
+		SerializeEnumBits(Ar, DesiredStance, 2);
+		SerializeEnumBits(Ar, DesiredRotationMode, 2);
+		SerializeEnumBits(Ar, RotationMode, 2);
+		SerializeEnumBits(Ar, OverlayState, 4);
+		SerializeEnumBits(Ar, FlightState, 2);
+		SerializeEnumBits(Ar, ViewMode, 1);
+
+		bOutSuccess = true;
+		return true;
+	}
+
+	friend bool operator==(const FALSReplicatedState& Lhs, const FALSReplicatedState& RHS)
+	{
+		return Lhs.DesiredGait == RHS.DesiredGait
+			&& Lhs.DesiredStance == RHS.DesiredStance
+			&& Lhs.DesiredRotationMode == RHS.DesiredRotationMode
+			&& Lhs.RotationMode == RHS.RotationMode
+			&& Lhs.OverlayState == RHS.OverlayState
+			&& Lhs.FlightState == RHS.FlightState
+			&& Lhs.ViewMode == RHS.ViewMode;
+	}
+
+	friend bool operator!=(const FALSReplicatedState& Lhs, const FALSReplicatedState& RHS)
+	{
+		return !(Lhs == RHS);
+	}
+
+private:
+	template <typename Enumeration>
+	static void SerializeEnumBits(FArchive& Ar, Enumeration& Value, const int64 NumBits)
+	{
+		uint8 Bits = Ar.IsSaving() ? static_cast<uint8>(Value) : 0;
+		Ar.SerializeBits(&Bits, NumBits);
+		Value = static_cast<Enumeration>(Bits);
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSReplicatedState> : public TStructOpsTypeTraitsBase2<FALSReplicatedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/**
+ * Ring buffer of timestamped ragdoll locations received over the network. Sampled slightly in the past, so remote
+ * ragdolls can be interpolated smoothly between the snapshots around the sample time.
+ */
+USTRUCT()
+struct FALSRagdollSnapshotBuffer
+{
+	GENERATED_BODY()
+
+	void Reset()
+	{
+		Head = 0;
+		Num = 0;
+	}
+
+	bool IsEmpty() const { return Num == 0; }
+
+	void Add(const float Time, const FVector& Location)
+	{
+		Head = (Head + 1) % Capacity;
+		Times[Head] = Time;
+		Locations[Head] = Location;
+		Num = FMath::Min(Num + 1, Capacity);
+	}
+
+	/** Location at Time, clamped to the oldest and newest snapshot. The buffer must not be empty. */
+	FVector Sample(const float Time) const
+	{
+		check(Num > 0);
+
+		int32 Newer = Head;
+		if (Time >= Times[Newer])
+		{
+			return Locations[Newer];
+		}
+
+		for (int32 i = 1; i < Num; ++i)
+		{
+			const int32 Older = (Head - i + Capacity) % Capacity;
+			if (Times[Older] <= Time)
+			{
+				const float Span = Times[Newer] - Times[Older];
+				const float Alpha = Span > SMALL_NUMBER ? (Time - Times[Older]) / Span : 1.0f;
+				return FMath::Lerp(Locations[Older], Locations[Newer], Alpha);
+			}
+			Newer = Older;
+		}
+
+		return Locations[Newer];
+	}
+
+private:
+	static constexpr int32 Capacity = 8;
+
+	FVector Locations[Capacity];
+	float Times[Capacity] = {};
+	int32 Head = 0;
+	int32 Num = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FALSNetDistanceBand
+{
+	GENERATED_BODY()
+
+	FALSNetDistanceBand() = default;
+
+	FALSNetDistanceBand(const float InDistance, const float InNetUpdateFrequency, const float InNetPriorityScale)
+		: Distance(InDistance), NetUpdateFrequency(InNetUpdateFrequency), NetPriorityScale(InNetPriorityScale)
+	{
+	}
+
+	/** Applies to characters up to this far from the closest player viewpoint */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 0, Units = "cm"))
+	float Distance = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 1))
+	float NetUpdateFrequency = 100.0f;
+
+	/** Scales the net priority for connections viewing from within this band */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 0))
+	float NetPriorityScale = 1.0f;
+};
+
+/**
+ * How often the server replicates a character, picked from its distance to the closest player and whether it is idle.
+ * State changes that remote players need to see quickly bump the character to the full rate for a short time.
+ */
+USTRUCT(BlueprintType)
+struct FALSNetUpdatePolicy
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy")
+	bool bEnabled = true;
+
+	/** Seconds between re-evaluating the policy */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 0.05))
+	float EvaluationInterval = 0.25f;
+
+	/** Sorted by distance. Characters beyond the last band use its values. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy")
+	TArray<FALSNetDistanceBand> DistanceBands = {
+		{1500.0f, 100.0f, 1.0f},
+		{5000.0f, 30.0f, 0.75f},
+		{15000.0f, 10.0f, 0.5f},
+	};
+
+	/**
+	 * Used when the character had no movement input, was standing still and did not turn its view for IdleDelay
+	 * seconds
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 1))
+	float IdleNetUpdateFrequency = 5.0f;
+
+	/** Turning the control rotation by more than this between evaluations keeps the character out of the idle rate */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 0, Units = "deg"))
+	float IdleControlRotationTolerance = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 0, Units = "s"))
+	float IdleDelay = 1.0f;
+
+	/** How long BumpNetUpdateFrequency keeps the character at the highest band's rate */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Net Update Policy", meta = (ClampMin = 0, Units = "s"))
+	float BumpDuration = 0.5f;
+
+	/** Band for the given distance. DistanceBands must not be empty. */
+	const FALSNetDistanceBand& GetBand(const float DistanceSquared) const
+	{
+		for (const FALSNetDistanceBand& Band : DistanceBands)
+		{
+			if (DistanceSquared <= FMath::Square(Band.Distance))
+			{
+				return Band;
+			}
+		}
+		return DistanceBands.Last();
+	}
+};
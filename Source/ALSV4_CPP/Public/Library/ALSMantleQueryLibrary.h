@@ -0,0 +1,65 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSMantleQueryLibrary.generated.h"
+
+class ACharacter;
+class ANavLinkProxy;
+
+/**
+ * Tests where a character could mantle without a live character, e.g. for AI planning routes over walls. Runs the
+ * traces of UALSMantleComponent::MantleCheck for many poses at once, in parallel on worker threads.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSMantleQueryLibrary final : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Runs a mantle check for each query. Results are in the same order as the queries. Unlike a live check, ledges on
+	 * moving objects are not rejected, as their velocity can't be read off the game thread.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System", meta = (WorldContext = "WorldContextObject"))
+	static void QueryMantleOpportunities(const UObject* WorldContextObject, const TArray<FALSMantleQuery>& Queries,
+	                                     const FALSMantleQuerySettings& Settings,
+	                                     TArray<FALSMantleQueryResult>& OutResults);
+
+	/**
+	 * Spawns a navigation link from the ground below each query to its ledge, for every result that can mantle. The
+	 * links only lead up, dropping down is left to the navmesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System", meta = (WorldContext = "WorldContextObject"))
+	static TArray<ANavLinkProxy*> SpawnMantleNavLinks(const UObject* WorldContextObject,
+	                                                  const TArray<FALSMantleQuery>& Queries,
+	                                                  const TArray<FALSMantleQueryResult>& Results,
+	                                                  const FALSMantleQuerySettings& Settings,
+	                                                  TSubclassOf<ANavLinkProxy> LinkClass);
+
+	/** Settings with the scaled capsule and the movement component of Character. */
+	UFUNCTION(BlueprintPure, Category = "ALS|Mantle System")
+	static FALSMantleQuerySettings MakeMantleQuerySettings(const ACharacter* Character,
+	                                                       const FALSMantleTraceSettings& TraceSettings);
+
+	/** Single query, callable from any thread. */
+	static FALSMantleQueryResult QueryMantleOpportunity(const UWorld* World, const FALSMantleQuery& Query,
+	                                                    const FALSMantleQuerySettings& Settings);
+
+	/**
+	 * Capsule sweep forward to find a wall the character cannot walk on. CapsuleBaseLocation is just below the bottom
+	 * of the capsule, see UALSMathLibrary::GetCapsuleBaseLocation.
+	 */
+	static void GetForwardTrace(const FALSMantleTraceSettings& TraceSettings, const FVector& CapsuleBaseLocation,
+	                            const FVector& TraceDirection, FVector& OutStart, FVector& OutEnd,
+	                            FCollisionShape& OutShape);
+
+	/** Sphere sweep down onto the top of the wall the forward trace hit at ImpactPoint. */
+	static void GetDownwardTrace(const FALSMantleTraceSettings& TraceSettings, const FVector& CapsuleBaseLocation,
+	                             const FVector& ImpactPoint, const FVector& ImpactNormal, FVector& OutStart,
+	                             FVector& OutEnd, FCollisionShape& OutShape);
+};
@@ -44,6 +44,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
 	static FVector GetCapsuleLocationFromBase(FVector BaseLocation, float ZOffset, UCapsuleComponent* Capsule);
 
+	/**
+	 * Sphere sweep CapsuleHasRoomCheck performs on ECC_Visibility, for a capsule of the scaled CapsuleRadius and
+	 * CapsuleHalfHeight centered at TargetLocation. Blocked if it hits anything.
+	 */
+	static void GetCapsuleHasRoomTrace(const FVector& TargetLocation, float CapsuleRadius, float CapsuleHalfHeight,
+	                                   float HeightOffset, float RadiusOffset, FVector& OutStart, FVector& OutEnd,
+	                                   float& OutRadius);
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
 	static bool CapsuleHasRoomCheck(UCapsuleComponent* Capsule, FVector TargetLocation, float HeightOffset,
 	                                float RadiusOffset, EDrawDebugTrace::Type DebugType = EDrawDebugTrace::Type::None, bool DrawDebugTrace = false);
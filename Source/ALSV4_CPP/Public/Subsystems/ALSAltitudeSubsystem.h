@@ -0,0 +1,56 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSAltitudeSubsystem.generated.h"
+
+/**
+ * Coarse 2D grid of static ground heights, used to answer altitude queries of flying characters without tracing
+ * through the whole atmosphere every frame. Cells are swept once, the first time a query lands in them, and keep the
+ * height of the highest static geometry anywhere in the cell, so the reported altitude is never above the real one.
+ * Callers should trace exactly when close to the ground. Cells under levels that are streamed in or out are rebuilt.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSAltitudeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Height of the static ground below Location, from the cell containing it. */
+	float GetGroundHeight(const FVector& Location);
+
+	/** Approximate altitude of Location above the static ground. May be negative over uneven ground. */
+	float GetCoarseAltitude(const FVector& Location) { return Location.Z - GetGroundHeight(Location); }
+
+	/** Forget cached cells overlapping Bounds, e.g. after static geometry was streamed in or out. */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Flight")
+	void InvalidateRegion(const FBox& Bounds);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Flight")
+	void InvalidateAll();
+
+private:
+	float BuildCell(const FIntPoint& Cell) const;
+
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+	float CellSize = 2000.0f;
+
+	TMap<FIntPoint, float> GroundHeights;
+
+	// Bounds of the streamed levels when they were added. Their components are already gone when they are removed.
+	TMap<TWeakObjectPtr<ULevel>, FBox> LevelBounds;
+
+	FDelegateHandle LevelAddedHandle;
+
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -0,0 +1,73 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSAtmosphereSubsystem.generated.h"
+
+class AALSAtmosphereVolume;
+
+/** Atmosphere at a point, as seen by flying characters. */
+USTRUCT(BlueprintType)
+struct FALSAtmosphereSample
+{
+	GENERATED_BODY()
+
+	/** Air density relative to sea level. */
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Atmosphere")
+	float Density = 1.0f;
+
+	/** Upward acceleration from updrafts, in cm/s^2. */
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Atmosphere")
+	float UpdraftAcceleration = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Atmosphere")
+	bool bNoFly = false;
+};
+
+/**
+ * Owns the atmosphere of a world: sea and troposphere altitudes, a density by altitude table baked from the project
+ * settings, and AALSAtmosphereVolume overrides. Volumes are bucketed into a 2D grid on registration, so sampling a
+ * point only tests the few volumes in its cell.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSAtmosphereSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Atmosphere")
+	FALSAtmosphereSample Sample(const FVector& Location) const;
+
+	/** Air density relative to sea level, without volume overrides. */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Atmosphere")
+	float GetDensityAtAltitude(float Altitude) const;
+
+	float GetSeaAltitude() const { return SeaAltitude; }
+
+	float GetTroposphereHeight() const { return TroposphereHeight; }
+
+	/** Volumes register themselves on BeginPlay. Their bounds are assumed not to change while registered. */
+	void RegisterVolume(AALSAtmosphereVolume* Volume);
+
+	void UnregisterVolume(AALSAtmosphereVolume* Volume);
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+
+	static constexpr int32 DensityTableSize = 256;
+
+	static constexpr float VolumeCellSize = 10000.0f;
+
+	float SeaAltitude = 0.0f;
+
+	float TroposphereHeight = 1000000.0f;
+
+	TArray<float> DensityTable;
+
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AALSAtmosphereVolume>>> VolumeCells;
+};
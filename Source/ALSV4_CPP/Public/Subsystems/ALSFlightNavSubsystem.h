@@ -0,0 +1,148 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "ALSFlightNavSubsystem.generated.h"
+
+class AALSFlightNavVolume;
+
+struct FALSFlightNavNode
+{
+	FVector Center = FVector::ZeroVector;
+
+	float HalfSize = 0.0f;
+
+	// Children are stored consecutively, indexed by octant: X = 1, Y = 2, Z = 4.
+	int32 FirstChild = INDEX_NONE;
+
+	// Range in FALSFlightNavOctree::Neighbors. Only set on navigable nodes.
+	int32 FirstNeighbor = 0;
+
+	int32 NumNeighbors = 0;
+
+	bool bBlocked = false;
+
+	bool IsLeaf() const { return FirstChild == INDEX_NONE; }
+
+	bool IsNavigable() const { return IsLeaf() && !bBlocked; }
+};
+
+/**
+ * Sparse voxel octree of the free space in a AALSFlightNavVolume. Free space is kept in nodes as large as possible,
+ * only space near geometry is subdivided down to the voxel size. Immutable once built, so queries may run on any
+ * thread while holding a reference.
+ */
+class ALSV4_CPP_API FALSFlightNavOctree
+{
+public:
+	/** Navigable leaf containing Point, or INDEX_NONE. */
+	int32 FindNavigableNode(const FVector& Point) const;
+
+	/** Like FindNavigableNode, but also searches one voxel around Point, e.g. for agents standing on the ground. */
+	int32 FindNearestNavigableNode(const FVector& Point) const;
+
+	/** Smallest node containing Point that is no smaller than MinHalfSize. */
+	int32 FindNode(const FVector& Point, float MinHalfSize) const;
+
+	/** A* over navigable nodes, straightened afterwards. Gives up after MaxIterations expanded nodes. */
+	bool FindPath(const FVector& Start, const FVector& End, int32 MaxIterations, TArray<FVector>& OutPath) const;
+
+	bool GetRandomReachablePoint(const FVector& Origin, float Radius, FVector& OutPoint) const;
+
+	bool IsSegmentClear(const FVector& Start, const FVector& End) const;
+
+	/** Navigable nodes sharing a face with NodeIndex. Used while building. */
+	void GatherNeighbors(int32 NodeIndex, TArray<int32>& OutNeighbors) const;
+
+	FBox Bounds;
+
+	float VoxelSize = 100.0f;
+
+	TArray<FALSFlightNavNode> Nodes;
+
+	TArray<int32> Neighbors;
+
+private:
+	void GatherFaceNodes(int32 NodeIndex, int32 Axis, bool bPositiveSide, TArray<int32>& OutNodes) const;
+};
+
+using FALSFlightNavOctreePtr = TSharedPtr<const FALSFlightNavOctree, ESPMode::ThreadSafe>;
+
+/** Path request that is solved on a worker thread. Poll bComplete on the game thread. */
+struct FALSFlightNavQuery
+{
+	FVector Start = FVector::ZeroVector;
+
+	FVector End = FVector::ZeroVector;
+
+	// Valid once bComplete is set.
+	TArray<FVector> Path;
+
+	bool bSuccess = false;
+
+	FThreadSafeBool bComplete = false;
+};
+
+using FALSFlightNavQueryPtr = TSharedPtr<FALSFlightNavQuery, ESPMode::ThreadSafe>;
+
+/**
+ * 3D navigation for flying AI. Builds a FALSFlightNavOctree for every AALSFlightNavVolume, time-sliced on the game
+ * thread because it relies on overlap tests, and solves path queries against the finished octrees on worker threads.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSFlightNavSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return !Builds.IsEmpty(); }
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// ~FTickableGameObject
+
+	/** (Re)builds the octree of Volume over the next frames. The previous octree stays in use until then. */
+	void RequestBuild(AALSFlightNavVolume* Volume);
+
+	void RemoveVolume(AALSFlightNavVolume* Volume);
+
+	/** Starts solving a path on a worker thread. Returns null if no built volume contains Start. */
+	FALSFlightNavQueryPtr FindPathAsync(const FVector& Start, const FVector& End, int32 MaxIterations = 20000) const;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Flight Navigation")
+	bool GetRandomReachablePoint(const FVector& Origin, float Radius, FVector& OutPoint) const;
+
+	/** Octree of a built volume containing Location. */
+	FALSFlightNavOctreePtr FindOctree(const FVector& Location) const;
+
+private:
+	struct FBuild
+	{
+		TWeakObjectPtr<AALSFlightNavVolume> Volume;
+
+		TSharedPtr<FALSFlightNavOctree, ESPMode::ThreadSafe> Octree;
+
+		// Nodes that still need to be classified.
+		TArray<int32> PendingNodes;
+
+		int32 NextNeighborNode = 0;
+
+		bool bClassified = false;
+	};
+
+	/** Returns true once the build is finished. */
+	bool ContinueBuild(FBuild& Build, double EndTime) const;
+
+	TArray<FBuild> Builds;
+
+	TMap<TWeakObjectPtr<AALSFlightNavVolume>, FALSFlightNavOctreePtr> Octrees;
+};
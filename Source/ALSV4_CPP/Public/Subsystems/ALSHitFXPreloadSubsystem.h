@@ -0,0 +1,64 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSHitFXPreloadSubsystem.generated.h"
+
+class UDataTable;
+
+/**
+ * Streams in the sounds, Niagara systems and decals of footstep hit FX tables ahead of time, so UALSAnimNotifyFootstep
+ * never loads them synchronously. Tables are found from the footstep notifies in memory when the world begins play, a
+ * level is added or a character spawns. Loaded assets are kept for the lifetime of the world.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSHitFXPreloadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Scans the footstep notifies in memory for tables to preload, on the next tick so spawns in one frame share it. */
+	void RequestScan();
+
+	/** Starts streaming in all assets referenced by the rows of DataTable. Does nothing if it was already started. */
+	void PreloadHitFX(UDataTable* DataTable);
+
+	/** The asset if it is loaded. Otherwise starts streaming it in and returns null, instead of blocking on it. */
+	template <typename T>
+	T* GetOrRequestAsset(const TSoftObjectPtr<T>& Asset)
+	{
+		if (T* Loaded = Asset.Get())
+		{
+			return Loaded;
+		}
+
+		RequestAsset(Asset.ToSoftObjectPath());
+		return nullptr;
+	}
+
+private:
+	void ScanLoadedNotifies();
+
+	void RequestAsset(const FSoftObjectPath& Path);
+
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+
+	// Handles keep the streamed assets loaded.
+	TMap<TWeakObjectPtr<UDataTable>, TSharedPtr<FStreamableHandle>> TableHandles;
+
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> AssetHandles;
+
+	FTimerHandle ScanTimer;
+
+	FDelegateHandle LevelAddedHandle;
+};
@@ -0,0 +1,125 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSLedgeSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/** Mantleable ledge, baked from static level geometry by UALSLedgeBakeCommandlet. */
+struct FALSLedge
+{
+	// Top of the ledge, on its edge.
+	FVector3f Location = FVector3f::ZeroVector;
+
+	// Horizontal, pointing away from the wall towards the side the ledge is mantled from.
+	FVector3f Normal = FVector3f::ZeroVector;
+
+	// Drop to the next surface in front of the ledge. Not limited, the drop of a ledge over nothing reaches the bottom
+	// of the baked area.
+	float Height = 0.0f;
+
+	// Index into FALSLedgeDatabase::ComponentPaths.
+	int32 Component = INDEX_NONE;
+
+	friend FArchive& operator<<(FArchive& Ar, FALSLedge& Ledge)
+	{
+		return Ar << Ledge.Location << Ledge.Normal << Ledge.Height << Ledge.Component;
+	}
+};
+
+struct FALSLedgeHit
+{
+	FALSLedge Ledge;
+
+	// Static component the ledge was baked from. Null if it was removed since the bake.
+	UPrimitiveComponent* Component = nullptr;
+};
+
+/** Ledges of one level, as stored on disk. Ledges are sorted by cell, so each cell's ledges are consecutive. */
+struct ALSV4_CPP_API FALSLedgeDatabase
+{
+	/** File the ledges of the level package LevelPackageName are baked to. */
+	static FString GetFilePath(const FString& LevelPackageName);
+
+	bool Save(const FString& FilePath);
+
+	bool Load(const FString& FilePath);
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Sorts the ledges by cell and rebuilds the cell ranges. */
+	void SortLedges();
+
+	// Area the bake covered. Outside of it, nothing is known about ledges.
+	FBox Bounds = FBox(ForceInit);
+
+	float CellSize = 200.0f;
+
+	// Distance between the samples taken along edges.
+	float Spacing = 25.0f;
+
+	TArray<FALSLedge> Ledges;
+
+	TArray<FString> ComponentPaths;
+
+	// First ledge and number of ledges in a cell. Not stored, rebuilt on load.
+	TMap<FIntVector, FIntPoint> Cells;
+};
+
+/**
+ * Answers whether static level geometry has a mantleable ledge within reach, from ledge databases baked per level.
+ * Databases are loaded as their levels are added to the world. UALSMantleComponent uses this to skip the sweeps of
+ * automatic mantle checks where there is nothing to mantle.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSLedgeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/**
+	 * Is Location inside the area of a loaded database, and outside of every loaded level without one. Elsewhere, ledge
+	 * queries can't rule anything out.
+	 */
+	bool IsCovered(const FVector& Location) const;
+
+	/**
+	 * Finds a ledge facing Direction within a capsule sweep of Radius from Start over Distance, with its top between
+	 * MinZ and MaxZ.
+	 */
+	bool FindLedgeInReach(const FVector& Start, const FVector& Direction, float Distance, float Radius, float MinZ,
+	                      float MaxZ, FALSLedgeHit* OutHit = nullptr) const;
+
+private:
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+	void LoadLevel(const ULevel* Level);
+
+	struct FLevelLedges
+	{
+		FALSLedgeDatabase Database;
+
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> Components;
+	};
+
+	TMap<FName, FLevelLedges> Levels;
+
+	// Bounds of the loaded levels that have no baked ledges.
+	TMap<FName, FBox> UnbakedLevels;
+
+	FDelegateHandle LevelAddedHandle;
+
+	FDelegateHandle LevelRemovedHandle;
+};
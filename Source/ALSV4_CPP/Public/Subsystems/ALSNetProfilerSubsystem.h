@@ -0,0 +1,103 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "ALSNetProfilerSubsystem.generated.h"
+
+class UNetDriver;
+
+/** Network stats of one world over one second. */
+struct FALSNetSample
+{
+	int32 NumCharacters = 0;
+
+	int64 InBytesPerSecond = 0;
+
+	int64 OutBytesPerSecond = 0;
+
+	// All outgoing bytes of the world divided by NumCharacters. Includes traffic that is not from ALS characters.
+	double AverageOutBytesPerCharacter = 0.0;
+
+	float FrameMs = 0.0f;
+
+	double GameThreadMs = 0.0;
+};
+
+/**
+ * Records the network cost of ALS characters to CSV files in the profiling directory, once per second:
+ * bytes per second in total and averaged over the characters, game thread time, and the RPCs sent by ALS characters
+ * and their components, as counted by the net driver.
+ * Every game world in the process records separately, so a multi client PIE session measures the server and all
+ * clients at once.
+ *
+ * Console commands, applied to all game worlds:
+ * ALS.Net.Profile.Start [Name]		Start recording to <Name>_<World>.csv and <Name>_<World>_RPCs.csv
+ * ALS.Net.Profile.Stop				Stop recording
+ * ALS.Net.Simulate <Loss%> <LagMs>	Simulate packet loss and latency on all net drivers (non shipping builds)
+ */
+UCLASS()
+class ALSV4_CPP_API UALSNetProfilerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return bRecording; }
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	// ~FTickableGameObject
+
+	void StartRecording(const FString& Name);
+
+	void StopRecording();
+
+	bool IsRecording() const { return bRecording; }
+
+	/** Number of samples written since recording started. */
+	int32 GetNumSamples() const { return NumSamples; }
+
+	const FALSNetSample& GetLastSample() const { return LastSample; }
+
+	void SimulateNetworkConditions(int32 PacketLossPercentage, int32 LatencyMs) const;
+
+private:
+	void WriteSample();
+
+	/** Hooks the RPCs of the world's current net driver, which may only exist after recording started. */
+	void BindNetDriver();
+
+	void UnbindNetDriver();
+
+	void OnSendRPC(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack,
+	               UObject* SubObject, bool& bBlockSendRPC);
+
+	bool bRecording = false;
+
+	FString StatsFilePath;
+
+	FString RPCFilePath;
+
+	double RecordingStartTime = 0.0;
+
+	float SampleTime = 0.0f;
+
+	int32 SampleFrames = 0;
+
+	double SampleGameThreadMs = 0.0;
+
+	TMap<FName, int32> RPCCounts;
+
+	TWeakObjectPtr<UNetDriver> BoundNetDriver;
+
+	int32 NumSamples = 0;
+
+	FALSNetSample LastSample;
+};
@@ -0,0 +1,42 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Volume.h"
+
+#include "ALSAtmosphereVolume.generated.h"
+
+/**
+ * Local change to the atmosphere for flying characters, e.g. an updraft, a storm or a no-fly zone.
+ * Overlapping volumes stack. The volume must not move while playing.
+ */
+UCLASS()
+class ALSV4_CPP_API AALSAtmosphereVolume : public AVolume
+{
+	GENERATED_BODY()
+
+public:
+	AALSAtmosphereVolume(const FObjectInitializer& ObjectInitializer);
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	const FBox& GetCachedBounds() const { return CachedBounds; }
+
+	/** Multiplies the air density inside, e.g. below 1 for thin, stormy air. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Atmosphere", meta = (ClampMin = 0))
+	float DensityScale = 1.0f;
+
+	/** Upward acceleration applied to flyers inside, in cm/s^2. Negative values push down. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Atmosphere")
+	float UpdraftAcceleration = 0.0f;
+
+	/** Flyers entering the volume stop flying. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Atmosphere")
+	bool bNoFly = false;
+
+private:
+	FBox CachedBounds;
+};
@@ -0,0 +1,44 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Volume.h"
+
+#include "ALSFlightNavVolume.generated.h"
+
+/** Space in which flying AI can path, see UALSFlightNavSubsystem. Only built on the server. */
+UCLASS()
+class ALSV4_CPP_API AALSFlightNavVolume : public AVolume
+{
+	GENERATED_BODY()
+
+public:
+	AALSFlightNavVolume(const FObjectInitializer& ObjectInitializer);
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Rebuilds the navigation data, e.g. after level geometry changed. */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Flight Navigation")
+	void RebuildNavigation();
+
+	/** Size of the smallest voxels, next to geometry. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Flight Navigation", meta = (ClampMin = 10))
+	float VoxelSize = 200.0f;
+
+	/** Free space keeps at least this distance to geometry. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Flight Navigation", meta = (ClampMin = 0))
+	float AgentRadius = 50.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Flight Navigation")
+	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_WorldStatic;
+
+	/** Game thread time spent on building per frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Flight Navigation", meta = (ClampMin = 0.1, Units = "ms"))
+	float BuildBudgetMs = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Flight Navigation")
+	bool bBuildOnBeginPlay = true;
+};